@@ -15,6 +15,8 @@
 #include "brave/browser/component_updater/brave_component_updater_configurator.h"
 #include "brave/browser/component_updater/brave_component_updater_delegate.h"
 #include "brave/browser/net/brave_system_request_handler.h"
+#include "brave/browser/net/query_filter_service.h"
+#include "brave/browser/net/static_redirect_service.h"
 #include "brave/browser/profiles/brave_profile_manager.h"
 #include "brave/browser/themes/brave_dark_mode_utils.h"
 #include "brave/browser/tor/buildflags.h"
@@ -180,6 +182,8 @@ void BraveBrowserProcessImpl::StartBraveServices() {
   extension_whitelist_service();
 #endif
   referrer_whitelist_service();
+  static_redirect_service();
+  query_filter_service();
   tracking_protection_service();
 #if BUILDFLAG(ENABLE_GREASELION)
   greaselion_download_service();
@@ -287,6 +291,23 @@ BraveBrowserProcessImpl::https_everywhere_service() {
   return https_everywhere_service_.get();
 }
 
+brave::StaticRedirectService*
+BraveBrowserProcessImpl::static_redirect_service() {
+  if (!static_redirect_service_) {
+    static_redirect_service_ =
+        brave::StaticRedirectServiceFactory(local_data_files_service());
+  }
+  return static_redirect_service_.get();
+}
+
+brave::QueryFilterService* BraveBrowserProcessImpl::query_filter_service() {
+  if (!query_filter_service_) {
+    query_filter_service_ =
+        brave::QueryFilterServiceFactory(local_data_files_service());
+  }
+  return query_filter_service_.get();
+}
+
 brave_component_updater::LocalDataFilesService*
 BraveBrowserProcessImpl::local_data_files_service() {
   if (!local_data_files_service_)
@@ -21,6 +21,8 @@ namespace brave {
 class BraveReferralsService;
 class BraveStatsUpdater;
 class BraveP3AService;
+class QueryFilterService;
+class StaticRedirectService;
 }  // namespace brave
 
 #if BUILDFLAG(BUNDLE_WIDEVINE_CDM)
@@ -87,6 +89,8 @@ class BraveBrowserProcessImpl : public BrowserProcessImpl {
 #endif
   brave_shields::TrackingProtectionService* tracking_protection_service();
   brave_shields::HTTPSEverywhereService* https_everywhere_service();
+  brave::StaticRedirectService* static_redirect_service();
+  brave::QueryFilterService* query_filter_service();
   brave_component_updater::LocalDataFilesService* local_data_files_service();
 #if BUILDFLAG(ENABLE_TOR)
   extensions::BraveTorClientUpdater* tor_client_updater();
@@ -140,6 +144,8 @@ class BraveBrowserProcessImpl : public BrowserProcessImpl {
       tracking_protection_service_;
   std::unique_ptr<brave_shields::HTTPSEverywhereService>
       https_everywhere_service_;
+  std::unique_ptr<brave::StaticRedirectService> static_redirect_service_;
+  std::unique_ptr<brave::QueryFilterService> query_filter_service_;
   std::unique_ptr<brave::BraveStatsUpdater> brave_stats_updater_;
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
   std::unique_ptr<brave::BraveReferralsService> brave_referrals_service_;
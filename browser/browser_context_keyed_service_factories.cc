@@ -10,6 +10,7 @@
 #include "brave/browser/search_engines/search_engine_provider_service_factory.h"
 #include "brave/browser/tor/tor_profile_service_factory.h"
 #include "brave/components/brave_ads/browser/ads_service_factory.h"
+#include "brave/components/brave_perf_predictor/browser/buildflags.h"
 #include "brave/components/brave_rewards/browser/rewards_service_factory.h"
 #include "brave/components/greaselion/browser/buildflags/buildflags.h"
 #include "brave/browser/ntp_sponsored_images/view_counter_service_factory.h"
@@ -27,6 +28,10 @@
 #include "brave/browser/brave_wallet/brave_wallet_service_factory.h"
 #endif
 
+#if BUILDFLAG(ENABLE_BRAVE_PERF_PREDICTOR)
+#include "brave/components/brave_perf_predictor/browser/p3a_bandwidth_savings_tracker_factory.h"
+#endif
+
 namespace brave {
 
 void EnsureBrowserContextKeyedServiceFactoriesBuilt() {
@@ -48,6 +53,10 @@ void EnsureBrowserContextKeyedServiceFactoriesBuilt() {
 #if BUILDFLAG(BRAVE_WALLET_ENABLED)
   BraveWalletServiceFactory::GetInstance();
 #endif
+
+#if BUILDFLAG(ENABLE_BRAVE_PERF_PREDICTOR)
+  brave_perf_predictor::P3ABandwidthSavingsTrackerFactory::GetInstance();
+#endif
 }
 
 }  // namespace brave
@@ -3,8 +3,14 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
+#include <set>
+#include <string>
+
+#include "base/files/file_util.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
+#include "base/strings/string_util.h"
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process_impl.h"
@@ -18,6 +24,8 @@
 #include "chrome/browser/extensions/extension_browsertest.h"
 #include "chrome/test/base/ui_test_utils.h"
 #include "content/public/test/browser_test_utils.h"
+#include "extensions/browser/extension_registry.h"
+#include "extensions/common/extension.h"
 #include "net/dns/mock_host_resolver.h"
 
 using brave_rewards::RewardsService;
@@ -120,6 +128,36 @@ class GreaselionServiceTest : public BaseLocalDataFilesBrowserTest {
     g_brave_browser_process->greaselion_download_service()->rules()->clear();
   }
 
+  // Returns the enabled extensions built for Greaselion rules.
+  std::set<const extensions::Extension*> GetGreaselionExtensions() {
+    std::set<const extensions::Extension*> extensions;
+    for (const auto& extension :
+         extensions::ExtensionRegistry::Get(profile())->enabled_extensions()) {
+      if (extension->location() == extensions::Manifest::COMPONENT &&
+          base::StartsWith(extension->name(), "greaselion-",
+                           base::CompareCase::SENSITIVE)) {
+        extensions.insert(extension.get());
+      }
+    }
+    return extensions;
+  }
+
+  // Returns the enabled extension built for the Greaselion rule named |name|.
+  const extensions::Extension* GetGreaselionExtension(const std::string& name) {
+    for (const extensions::Extension* extension : GetGreaselionExtensions()) {
+      if (extension->name() == name)
+        return extension;
+    }
+    return nullptr;
+  }
+
+  void UpdateInstalledExtensions() {
+    GreaselionService* greaselion_service =
+        GreaselionServiceFactory::GetForBrowserContext(profile());
+    greaselion_service->UpdateInstalledExtensions();
+    GreaselionServiceWaiter(greaselion_service).Wait();
+  }
+
   void SetRewardsEnabled(bool enabled) {
     RewardsService* rewards_service =
         RewardsServiceFactory::GetForProfile(profile());
@@ -199,3 +237,106 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, ScriptInjectionWithPrecondition) {
   // Greaselion rule is active
   EXPECT_EQ(title, "Altered");
 }
+
+// Ensure that toggling a precondition only installs or unloads the rules it
+// affects, and that a rule enabled again is installed from the extension built
+// the first time.
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, IncrementalReinstall) {
+  ASSERT_TRUE(InstallMockExtension());
+  const std::set<const extensions::Extension*> initial_extensions =
+      GetGreaselionExtensions();
+  EXPECT_EQ(2u, initial_extensions.size());
+
+  SetRewardsEnabled(true);
+  const std::set<const extensions::Extension*> rewards_extensions =
+      GetGreaselionExtensions();
+  EXPECT_EQ(3u, rewards_extensions.size());
+  // The rules without preconditions have not been installed again.
+  EXPECT_TRUE(std::includes(rewards_extensions.begin(),
+                            rewards_extensions.end(),
+                            initial_extensions.begin(),
+                            initial_extensions.end()));
+
+  SetRewardsEnabled(false);
+  EXPECT_EQ(initial_extensions, GetGreaselionExtensions());
+
+  SetRewardsEnabled(true);
+  EXPECT_EQ(rewards_extensions, GetGreaselionExtensions());
+
+  GURL url = embedded_test_server()->GetURL("pre1.example.com", "/simple.html");
+  ui_test_utils::NavigateToURL(browser(), url);
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+  ASSERT_TRUE(content::WaitForLoadStop(contents));
+  std::string title;
+  ASSERT_TRUE(
+      ExecuteScriptAndExtractString(contents,
+                                    "window.domAutomationController.send("
+                                    "document.title)",
+                                    &title));
+  EXPECT_EQ(title, "Altered");
+}
+
+// Ensure that an update keeps the extensions of the rules whose scripts did not
+// change, and rebuilds the extension of a rule whose script changed.
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, RebuildsChangedRulesOnly) {
+  ASSERT_TRUE(InstallMockExtension());
+  const std::set<const extensions::Extension*> initial_extensions =
+      GetGreaselionExtensions();
+  EXPECT_EQ(2u, initial_extensions.size());
+
+  UpdateInstalledExtensions();
+  EXPECT_EQ(initial_extensions, GetGreaselionExtensions());
+
+  std::string a_com_rule_name;
+  base::FilePath a_com_script;
+  for (const auto& rule :
+       *g_brave_browser_process->greaselion_download_service()->rules()) {
+    if (rule->scripts()[0].BaseName().value() ==
+        FILE_PATH_LITERAL("a-com.js")) {
+      a_com_rule_name = rule->name();
+      a_com_script = rule->scripts()[0];
+    }
+  }
+  ASSERT_FALSE(a_com_script.empty());
+  const extensions::Extension* a_com_extension =
+      GetGreaselionExtension(a_com_rule_name);
+  ASSERT_TRUE(a_com_extension);
+  const base::FilePath a_com_extension_path = a_com_extension->path();
+
+  {
+    // Appending changes the size, so the change is detected even where the
+    // modification time is too coarse to differ.
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    const std::string suffix = "\n// changed\n";
+    ASSERT_TRUE(base::AppendToFile(a_com_script, suffix.data(),
+                                   static_cast<int>(suffix.size())));
+  }
+  UpdateInstalledExtensions();
+
+  const std::set<const extensions::Extension*> updated_extensions =
+      GetGreaselionExtensions();
+  EXPECT_EQ(2u, updated_extensions.size());
+  const extensions::Extension* rebuilt_extension =
+      GetGreaselionExtension(a_com_rule_name);
+  ASSERT_TRUE(rebuilt_extension);
+  EXPECT_NE(a_com_extension_path, rebuilt_extension->path());
+  for (const extensions::Extension* extension : initial_extensions) {
+    if (extension != a_com_extension)
+      EXPECT_TRUE(updated_extensions.count(extension));
+  }
+
+  // The rebuilt extension still injects its script.
+  GURL url = embedded_test_server()->GetURL("www.a.com", "/simple.html");
+  ui_test_utils::NavigateToURL(browser(), url);
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+  ASSERT_TRUE(content::WaitForLoadStop(contents));
+  std::string title;
+  ASSERT_TRUE(
+      ExecuteScriptAndExtractString(contents,
+                                    "window.domAutomationController.send("
+                                    "document.title)",
+                                    &title));
+  EXPECT_EQ(title, "Altered");
+}
@@ -7,14 +7,19 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/base64url.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_util.h"
+#include "base/task/post_task.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/shield_exceptions.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
+#include "brave/components/brave_shields/browser/ad_block_engine_facade.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
@@ -29,31 +34,47 @@ using content::ResourceType;
 
 namespace brave {
 
-void ShouldBlockAdOnTaskRunner(std::shared_ptr<BraveRequestInfo> ctx) {
-  bool did_match_exception = false;
-  std::string tab_host = ctx->tab_origin.host();
-  if (!g_brave_browser_process->ad_block_service()->ShouldStartRequest(
-          ctx->request_url, ctx->resource_type, tab_host,
-          &did_match_exception, &ctx->cancel_request_explicitly,
-          &ctx->mock_data_url)) {
-    ctx->blocked_by = kAdBlocked;
-  } else if (!did_match_exception &&
-             !g_brave_browser_process->ad_block_regional_service_manager()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
-                                       &ctx->cancel_request_explicitly,
-                                       &ctx->mock_data_url)) {
-    ctx->blocked_by = kAdBlocked;
-  } else if (!did_match_exception &&
-             !g_brave_browser_process->ad_block_custom_filters_service()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
-                                       &ctx->cancel_request_explicitly,
-                                       &ctx->mock_data_url)) {
+namespace {
+
+struct PendingAdBlockCheck {
+  ResponseCallback next_callback;
+  std::shared_ptr<BraveRequestInfo> ctx;
+};
+
+using PendingAdBlockChecks = std::vector<PendingAdBlockCheck>;
+
+// Checks queued on the UI thread while the maximum number of batches is
+// being matched. They all go over in the next hop.
+PendingAdBlockChecks* GetQueuedAdBlockChecks() {
+  static base::NoDestructor<PendingAdBlockChecks> queued_checks;
+  return queued_checks.get();
+}
+
+// Engines are immutable snapshots, so batches can be matched in parallel on
+// the thread pool.
+constexpr int kMaxAdBlockBatchesInFlight = 4;
+int g_ad_block_batches_in_flight = 0;
+
+void ShouldBlockAdOnTaskRunner(brave_shields::AdBlockEngineFacade* engine,
+                               std::shared_ptr<BraveRequestInfo> ctx) {
+  const brave_shields::AdBlockRequest request(
+      ctx->request_url, ctx->resource_type, ctx->tab_origin.host());
+  if (!engine->ShouldStartRequest(request, &ctx->cancel_request_explicitly,
+                                  &ctx->mock_data_url)) {
     ctx->blocked_by = kAdBlocked;
   }
 }
 
+void ShouldBlockAdsOnTaskRunner(PendingAdBlockChecks* checks) {
+  brave_shields::AdBlockEngineFacade engine(
+      g_brave_browser_process->ad_block_service(),
+      g_brave_browser_process->ad_block_regional_service_manager(),
+      g_brave_browser_process->ad_block_custom_filters_service());
+  for (const auto& check : *checks) {
+    ShouldBlockAdOnTaskRunner(&engine, check.ctx);
+  }
+}
+
 void OnShouldBlockAdResult(const ResponseCallback& next_callback,
                            std::shared_ptr<BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
@@ -66,6 +87,41 @@ void OnShouldBlockAdResult(const ResponseCallback& next_callback,
   next_callback.Run();
 }
 
+void PostQueuedAdBlockChecks();
+
+void OnShouldBlockAdsResult(std::unique_ptr<PendingAdBlockChecks> checks) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  --g_ad_block_batches_in_flight;
+  // Send whatever queued up meanwhile before resuming the finished requests,
+  // so matching of the next batch overlaps with their dispatch.
+  PostQueuedAdBlockChecks();
+  for (const auto& check : *checks) {
+    OnShouldBlockAdResult(check.next_callback, check.ctx);
+  }
+}
+
+void PostQueuedAdBlockChecks() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  PendingAdBlockChecks* queued_checks = GetQueuedAdBlockChecks();
+  if (g_ad_block_batches_in_flight >= kMaxAdBlockBatchesInFlight ||
+      queued_checks->empty())
+    return;
+
+  auto checks = std::make_unique<PendingAdBlockChecks>();
+  checks->swap(*queued_checks);
+  PendingAdBlockChecks* checks_ptr = checks.get();
+  ++g_ad_block_batches_in_flight;
+  base::PostTaskAndReply(
+      FROM_HERE,
+      {base::ThreadPool(), base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&ShouldBlockAdsOnTaskRunner,
+                     base::Unretained(checks_ptr)),
+      base::BindOnce(&OnShouldBlockAdsResult, std::move(checks)));
+}
+
+}  // namespace
+
 void OnBeforeURLRequestAdBlockTP(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
@@ -78,11 +134,10 @@ void OnBeforeURLRequestAdBlockTP(
   }
   DCHECK_NE(ctx->request_identifier, 0UL);
 
-  g_brave_browser_process->ad_block_service()->GetTaskRunner()
-      ->PostTaskAndReply(FROM_HERE,
-                         base::BindOnce(&ShouldBlockAdOnTaskRunner, ctx),
-                         base::BindOnce(&OnShouldBlockAdResult, next_callback,
-                                        ctx));
+  // Requests are matched in batches: one hop carries every check queued
+  // while earlier batches were being matched.
+  GetQueuedAdBlockChecks()->push_back({next_callback, ctx});
+  PostQueuedAdBlockChecks();
 }
 
 int OnBeforeURLRequest_AdBlockTPPreWork(
@@ -9,6 +9,10 @@
 #include <string>
 #include <vector>
 
+#include "base/no_destructor.h"
+#include "brave/browser/brave_browser_process_impl.h"
+#include "brave/browser/net/static_redirect_service.h"
+#include "brave/browser/net/static_redirect_table.h"
 #include "brave/common/network_constants.h"
 #include "components/component_updater/component_updater_url_constants.h"
 #include "extensions/buildflags/buildflags.h"
@@ -20,27 +24,43 @@
 
 namespace brave {
 
-// Update server checks happen from the profile context for admin policy
-// installed extensions. Update server checks happen from the system context for
-// normal update operations.
-bool IsUpdaterURL(const GURL& gurl) {
-  static std::vector<URLPattern> updater_patterns(
-      {URLPattern(URLPattern::SCHEME_HTTPS,
-                  std::string(component_updater::kUpdaterJSONDefaultUrl) + "*"),
-       URLPattern(
-           URLPattern::SCHEME_HTTP,
-           std::string(component_updater::kUpdaterJSONFallbackUrl) + "*"),
+namespace {
+
+std::vector<StaticRedirectTable::Entry> GetCommonStaticRedirects() {
+  using Entry = StaticRedirectTable::Entry;
+  using Rewrite = StaticRedirectTable::Rewrite;
+  const int kHttpAndHttps = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+  Entry clients4(URLPattern(kHttpAndHttps, kClients4Prefix),
+                 Rewrite::kHttpsHost, kBraveClients4Proxy);
+  clients4.match_host_only = true;
+
+  return {
+      // Update server checks happen from the profile context for admin policy
+      // installed extensions. Update server checks happen from the system
+      // context for normal update operations.
+      Entry(URLPattern(URLPattern::SCHEME_HTTPS,
+                       std::string(component_updater::kUpdaterJSONDefaultUrl) +
+                           "*"),
+            Rewrite::kURLWithQuery, kBraveUpdatesExtensionsEndpoint),
+      Entry(URLPattern(URLPattern::SCHEME_HTTP,
+                       std::string(component_updater::kUpdaterJSONFallbackUrl) +
+                           "*"),
+            Rewrite::kURLWithQuery, kBraveUpdatesExtensionsEndpoint),
 #if BUILDFLAG(ENABLE_EXTENSIONS)
-       URLPattern(
-           URLPattern::SCHEME_HTTPS,
-           std::string(extension_urls::kChromeWebstoreUpdateURL) + "*")
+      Entry(URLPattern(URLPattern::SCHEME_HTTPS,
+                       std::string(extension_urls::kChromeWebstoreUpdateURL) +
+                           "*"),
+            Rewrite::kURLWithQuery, kBraveUpdatesExtensionsEndpoint),
 #endif
-  });
-  return std::any_of(
-      updater_patterns.begin(), updater_patterns.end(),
-      [&gurl](URLPattern pattern) { return pattern.MatchesURL(gurl); });
+      Entry(URLPattern(kHttpAndHttps, kChromeCastPrefix), Rewrite::kHttpsHost,
+            kBraveRedirectorProxy),
+      clients4,
+  };
 }
 
+}  // namespace
+
 int OnBeforeURLRequest_CommonStaticRedirectWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
@@ -58,35 +78,18 @@ int OnBeforeURLRequest_CommonStaticRedirectWorkForGURL(
     GURL* new_url) {
   DCHECK(new_url);
 
-  GURL::Replacements replacements;
-  static URLPattern chromecast_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kChromeCastPrefix);
-  static URLPattern clients4_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kClients4Prefix);
-
-  if (IsUpdaterURL(request_url)) {
-    replacements.SetQueryStr(request_url.query_piece());
-    *new_url = GURL(kBraveUpdatesExtensionsEndpoint)
-                            .ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (chromecast_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
+  static const base::NoDestructor<StaticRedirectTable> redirects(
+      GetCommonStaticRedirects());
+  if (redirects->Redirect(request_url, new_url))
     return net::OK;
-  }
 
-  if (clients4_pattern.MatchesHost(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveClients4Proxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
+  // Redirects delivered by component update can't override the built-in ones
+  if (g_brave_browser_process &&
+      g_brave_browser_process->static_redirect_service()) {
+    g_brave_browser_process->static_redirect_service()->Redirect(request_url,
+                                                                  new_url);
   }
-
   return net::OK;
 }
 
-
 }  // namespace brave
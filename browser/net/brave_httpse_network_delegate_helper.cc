@@ -9,8 +9,6 @@
 #include <memory>
 #include <string>
 
-#include "base/task/post_task.h"
-#include "base/threading/scoped_blocking_call.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/https_everywhere_service.h"
@@ -21,30 +19,6 @@ using content::BrowserThread;
 
 namespace brave {
 
-void OnBeforeURLRequest_HttpseFileWork(
-    std::shared_ptr<BraveRequestInfo> ctx) {
-  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
-                                                base::BlockingType::WILL_BLOCK);
-  DCHECK_NE(ctx->request_identifier, 0U);
-  g_brave_browser_process->https_everywhere_service()->
-    GetHTTPSURL(&ctx->request_url, ctx->request_identifier, &ctx->new_url_spec);
-}
-
-void OnBeforeURLRequest_HttpsePostFileWork(
-    const ResponseCallback& next_callback,
-    std::shared_ptr<BraveRequestInfo> ctx) {
-  DCHECK_CURRENTLY_ON(BrowserThread::UI);
-
-  if (!ctx->new_url_spec.empty() &&
-    ctx->new_url_spec != ctx->request_url.spec()) {
-    brave_shields::DispatchBlockedEvent(ctx->request_url,
-        ctx->render_frame_id, ctx->render_process_id, ctx->frame_tree_node_id,
-        brave_shields::kHTTPUpgradableResources);
-  }
-
-  next_callback.Run();
-}
-
 int OnBeforeURLRequest_HttpsePreFileWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
@@ -70,26 +44,17 @@ int OnBeforeURLRequest_HttpsePreFileWork(
     }
   }
 
-  if (is_valid_url) {
-    if (!g_brave_browser_process->https_everywhere_service()->
-        GetHTTPSURLFromCacheOnly(&ctx->request_url,
-                                 ctx->request_identifier,
-                                 &ctx->new_url_spec)) {
-      g_brave_browser_process->https_everywhere_service()->
-        GetTaskRunner()->PostTaskAndReply(FROM_HERE,
-          base::Bind(OnBeforeURLRequest_HttpseFileWork, ctx),
-          base::Bind(base::IgnoreResult(
-              &OnBeforeURLRequest_HttpsePostFileWork),
-              next_callback, ctx));
-      return net::ERR_IO_PENDING;
-    } else {
-      if (!ctx->new_url_spec.empty()) {
-        brave_shields::DispatchBlockedEvent(ctx->request_url,
-            ctx->render_frame_id, ctx->render_process_id,
-            ctx->frame_tree_node_id,
-            brave_shields::kHTTPUpgradableResources);
-      }
-    }
+  // The rules are held in memory, so the lookup is answered right away
+  // instead of on the HTTPSE task runner.
+  if (is_valid_url &&
+      g_brave_browser_process->https_everywhere_service()->GetHTTPSURL(
+          &ctx->request_url, ctx->request_identifier, &ctx->new_url_spec) &&
+      !ctx->new_url_spec.empty() &&
+      ctx->new_url_spec != ctx->request_url.spec()) {
+    brave_shields::DispatchBlockedEvent(ctx->request_url,
+        ctx->render_frame_id, ctx->render_process_id,
+        ctx->frame_tree_node_id,
+        brave_shields::kHTTPUpgradableResources);
   }
 
   return net::OK;
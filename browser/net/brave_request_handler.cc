@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/metrics/histogram.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/task/post_task.h"
 #include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
@@ -42,6 +43,20 @@
 #include "brave/browser/net/brave_translate_redirect_network_delegate_helper.h"
 #endif
 
+namespace {
+
+// Looked up once per stage, with the parameters of UmaHistogramTimes, so
+// recording a sample doesn't build a name or go through the
+// StatisticsRecorder.
+base::HistogramBase* CreateStageHistogram(const std::string& name) {
+  return base::Histogram::FactoryTimeGet(
+      name, base::TimeDelta::FromMilliseconds(1),
+      base::TimeDelta::FromSeconds(10), 50,
+      base::HistogramBase::kUmaTargetedHistogramFlag);
+}
+
+}  // namespace
+
 BraveRequestHandler::BraveRequestHandler() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   SetupCallbacks();
@@ -52,47 +67,63 @@ BraveRequestHandler::BraveRequestHandler() {
 BraveRequestHandler::~BraveRequestHandler() = default;
 
 void BraveRequestHandler::SetupCallbacks() {
-  brave::OnBeforeURLRequestCallback callback =
-      base::Bind(brave::OnBeforeURLRequest_SiteHacksWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback = base::Bind(brave::OnBeforeURLRequest_AdBlockTPPreWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback = base::Bind(brave::OnBeforeURLRequest_HttpsePreFileWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback = base::Bind(brave::OnBeforeURLRequest_CommonStaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestStage("SiteHacks",
+                           base::Bind(brave::OnBeforeURLRequest_SiteHacksWork));
+  AddBeforeURLRequestStage(
+      "AdBlock", base::Bind(brave::OnBeforeURLRequest_AdBlockTPPreWork));
+  AddBeforeURLRequestStage(
+      "HTTPSE", base::Bind(brave::OnBeforeURLRequest_HttpsePreFileWork));
+  AddBeforeURLRequestStage(
+      "StaticRedirect",
+      base::Bind(brave::OnBeforeURLRequest_CommonStaticRedirectWork));
 
 #if BUILDFLAG(BRAVE_REWARDS_ENABLED)
-  callback = base::Bind(brave_rewards::OnBeforeURLRequest);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestStage("Rewards",
+                           base::Bind(brave_rewards::OnBeforeURLRequest));
 #endif
 
 #if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_TranslateRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestStage(
+      "TranslateRedirect",
+      base::BindRepeating(brave::OnBeforeURLRequest_TranslateRedirectWork));
 #endif
 
-  brave::OnBeforeStartTransactionCallback start_transaction_callback =
-      base::Bind(brave::OnBeforeStartTransaction_SiteHacksWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+  AddBeforeStartTransactionStage(
+      "SiteHacks", base::Bind(brave::OnBeforeStartTransaction_SiteHacksWork));
 
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
-  start_transaction_callback =
-      base::Bind(brave::OnBeforeStartTransaction_ReferralsWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+  AddBeforeStartTransactionStage(
+      "Referrals", base::Bind(brave::OnBeforeStartTransaction_ReferralsWork));
 #endif
 
 #if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
-  brave::OnHeadersReceivedCallback headers_received_callback =
-      base::Bind(webtorrent::OnHeadersReceived_TorrentRedirectWork);
-  headers_received_callbacks_.push_back(headers_received_callback);
+  AddHeadersReceivedStage(
+      "TorrentRedirect",
+      base::Bind(webtorrent::OnHeadersReceived_TorrentRedirectWork));
 #endif
 }
 
+void BraveRequestHandler::AddBeforeURLRequestStage(
+    const std::string& name,
+    const brave::OnBeforeURLRequestCallback& cb) {
+  before_url_request_stages_.push_back(
+      {CreateStageHistogram("Brave.OnBeforeURLRequest." + name), cb});
+}
+
+void BraveRequestHandler::AddBeforeStartTransactionStage(
+    const std::string& name,
+    const brave::OnBeforeStartTransactionCallback& cb) {
+  before_start_transaction_stages_.push_back(
+      {CreateStageHistogram("Brave.OnBeforeStartTransaction." + name), cb});
+}
+
+void BraveRequestHandler::AddHeadersReceivedStage(
+    const std::string& name,
+    const brave::OnHeadersReceivedCallback& cb) {
+  headers_received_stages_.push_back(
+      {CreateStageHistogram("Brave.OnHeadersReceived." + name), cb});
+}
+
 void BraveRequestHandler::InitPrefChangeRegistrar() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
@@ -125,30 +156,26 @@ int BraveRequestHandler::OnBeforeURLRequest(
     std::shared_ptr<brave::BraveRequestInfo> ctx,
     net::CompletionOnceCallback callback,
     GURL* new_url) {
-  if (before_url_request_callbacks_.empty()) {
+  if (before_url_request_stages_.empty()) {
     return net::OK;
   }
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.OnBeforeURLRequest_Handler");
   ctx->new_url = new_url;
   ctx->event_type = brave::kOnBeforeRequest;
-  callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartPipeline(ctx, std::move(callback));
 }
 
 int BraveRequestHandler::OnBeforeStartTransaction(
     std::shared_ptr<brave::BraveRequestInfo> ctx,
     net::CompletionOnceCallback callback,
     net::HttpRequestHeaders* headers) {
-  if (before_start_transaction_callbacks_.empty()) {
+  if (before_start_transaction_stages_.empty()) {
     return net::OK;
   }
   ctx->event_type = brave::kOnBeforeStartTransaction;
   ctx->headers = headers;
   ctx->referral_headers_list = referral_headers_list_.get();
-  callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartPipeline(ctx, std::move(callback));
 }
 
 int BraveRequestHandler::OnHeadersReceived(
@@ -163,18 +190,15 @@ int BraveRequestHandler::OnHeadersReceived(
         original_response_headers, override_response_headers);
   }
 
-  if (headers_received_callbacks_.empty()) {
+  if (headers_received_stages_.empty()) {
     return net::OK;
   }
 
-  callbacks_[ctx->request_identifier] = std::move(callback);
   ctx->event_type = brave::kOnHeadersReceived;
   ctx->original_response_headers = original_response_headers;
   ctx->override_response_headers = override_response_headers;
   ctx->allowed_unsafe_redirect_url = allowed_unsafe_redirect_url;
-
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartPipeline(ctx, std::move(callback));
 }
 
 void BraveRequestHandler::OnURLRequestDestroyed(
@@ -195,8 +219,127 @@ void BraveRequestHandler::RunCallbackForRequestIdentifier(
                  base::BindOnce(std::move(it->second), rv));
 }
 
-// TODO(iefremov): Merge all callback containers into one and run only one loop
-// instead of many (issues/5574).
+int BraveRequestHandler::StartPipeline(
+    std::shared_ptr<brave::BraveRequestInfo> ctx,
+    net::CompletionOnceCallback callback) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  // Registered up front, since a stage may complete before returning.
+  callbacks_[ctx->request_identifier] = std::move(callback);
+  int rv = RunStages(ctx);
+  if (rv == net::ERR_IO_PENDING) {
+    return rv;
+  }
+
+  // Most requests pass every stage synchronously and untouched. Those are
+  // answered right away rather than through another UI task; anything that
+  // was redirected or blocked keeps going through the callback.
+  const bool redirected =
+      ctx->event_type == brave::kOnBeforeRequest &&
+      !ctx->new_url_spec.empty() &&
+      ctx->new_url_spec != ctx->request_url.spec();
+  if (rv == net::OK && !redirected && ctx->blocked_by == brave::kNotBlocked) {
+    callbacks_.erase(ctx->request_identifier);
+    return net::OK;
+  }
+
+  FinishPipeline(ctx, rv);
+  return net::ERR_IO_PENDING;
+}
+
+size_t BraveRequestHandler::GetStageCount(
+    brave::BraveNetworkDelegateEventType event_type) const {
+  switch (event_type) {
+    case brave::kOnBeforeRequest:
+      return before_url_request_stages_.size();
+    case brave::kOnBeforeStartTransaction:
+      return before_start_transaction_stages_.size();
+    case brave::kOnHeadersReceived:
+      return headers_received_stages_.size();
+    default:
+      return 0;
+  }
+}
+
+base::HistogramBase* BraveRequestHandler::GetStageHistogram(
+    brave::BraveNetworkDelegateEventType event_type,
+    size_t index) const {
+  switch (event_type) {
+    case brave::kOnBeforeRequest:
+      return before_url_request_stages_[index].histogram;
+    case brave::kOnBeforeStartTransaction:
+      return before_start_transaction_stages_[index].histogram;
+    default:
+      DCHECK_EQ(event_type, brave::kOnHeadersReceived);
+      return headers_received_stages_[index].histogram;
+  }
+}
+
+int BraveRequestHandler::RunStage(
+    std::shared_ptr<brave::BraveRequestInfo> ctx,
+    size_t index,
+    const brave::ResponseCallback& next_callback) {
+  switch (ctx->event_type) {
+    case brave::kOnBeforeRequest:
+      return before_url_request_stages_[index].callback.Run(next_callback,
+                                                            ctx);
+    case brave::kOnBeforeStartTransaction:
+      return before_start_transaction_stages_[index].callback.Run(
+          ctx->headers, next_callback, ctx);
+    case brave::kOnHeadersReceived:
+      return headers_received_stages_[index].callback.Run(
+          ctx->original_response_headers, ctx->override_response_headers,
+          ctx->allowed_unsafe_redirect_url, next_callback, ctx);
+    default:
+      NOTREACHED();
+      return net::OK;
+  }
+}
+
+int BraveRequestHandler::RunStages(
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  const size_t stage_count = GetStageCount(ctx->event_type);
+  if (ctx->next_url_request_index == stage_count) {
+    return net::OK;
+  }
+
+  // One continuation serves every stage of this pass.
+  brave::ResponseCallback next_callback =
+      base::Bind(&BraveRequestHandler::OnStageComplete,
+                 weak_factory_.GetWeakPtr(), ctx);
+  // Continue processing stages until we hit one that returns PENDING.
+  while (ctx->next_url_request_index != stage_count) {
+    const size_t index = ctx->next_url_request_index++;
+    ctx->stage_start_time = base::TimeTicks::Now();
+    int rv = RunStage(ctx, index, next_callback);
+    if (rv == net::ERR_IO_PENDING) {
+      return rv;
+    }
+    RecordStageTime(ctx, index);
+    if (rv != net::OK) {
+      return rv;
+    }
+  }
+  return net::OK;
+}
+
+void BraveRequestHandler::RecordStageTime(
+    std::shared_ptr<brave::BraveRequestInfo> ctx,
+    size_t index) {
+  // For pending stages this includes the time spent waiting for a worker.
+  GetStageHistogram(ctx->event_type, index)
+      ->AddTimeMillisecondsGranularity(base::TimeTicks::Now() -
+                                       ctx->stage_start_time);
+}
+
+void BraveRequestHandler::OnStageComplete(
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK_GT(ctx->next_url_request_index, 0u);
+  RecordStageTime(ctx, ctx->next_url_request_index - 1);
+  RunNextCallback(ctx);
+}
+
 void BraveRequestHandler::RunNextCallback(
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
@@ -205,63 +348,16 @@ void BraveRequestHandler::RunNextCallback(
     return;
   }
 
-  // Continue processing callbacks until we hit one that returns PENDING
-  int rv = net::OK;
-
-  if (ctx->event_type == brave::kOnBeforeRequest) {
-    while (before_url_request_callbacks_.size() !=
-           ctx->next_url_request_index) {
-      brave::OnBeforeURLRequestCallback callback =
-          before_url_request_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback = base::Bind(
-          &BraveRequestHandler::RunNextCallback,
-          weak_factory_.GetWeakPtr(),
-          ctx);
-      rv = callback.Run(next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
-      if (rv != net::OK) {
-        break;
-      }
-    }
-  } else if (ctx->event_type == brave::kOnBeforeStartTransaction) {
-    while (before_start_transaction_callbacks_.size() !=
-           ctx->next_url_request_index) {
-      brave::OnBeforeStartTransactionCallback callback =
-          before_start_transaction_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback = base::Bind(
-          &BraveRequestHandler::RunNextCallback,
-          weak_factory_.GetWeakPtr(),
-          ctx);
-      rv = callback.Run(ctx->headers, next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
-      if (rv != net::OK) {
-        break;
-      }
-    }
-  } else if (ctx->event_type == brave::kOnHeadersReceived) {
-    while (headers_received_callbacks_.size() != ctx->next_url_request_index) {
-      brave::OnHeadersReceivedCallback callback =
-          headers_received_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback = base::Bind(
-          &BraveRequestHandler::RunNextCallback,
-          weak_factory_.GetWeakPtr(),
-          ctx);
-      rv = callback.Run(ctx->original_response_headers,
-                        ctx->override_response_headers,
-                        ctx->allowed_unsafe_redirect_url, next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
-      if (rv != net::OK) {
-        break;
-      }
-    }
+  int rv = RunStages(ctx);
+  if (rv == net::ERR_IO_PENDING) {
+    return;
   }
+  FinishPipeline(ctx, rv);
+}
 
+void BraveRequestHandler::FinishPipeline(
+    std::shared_ptr<brave::BraveRequestInfo> ctx,
+    int rv) {
   if (rv != net::OK) {
     RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
     return;
@@ -17,6 +17,10 @@
 
 class PrefChangeRegistrar;
 
+namespace base {
+class HistogramBase;
+}  // namespace base
+
 // Contains different network stack hooks (similar to capabilities of WebRequest
 // API).
 class BraveRequestHandler {
@@ -52,12 +56,45 @@ class BraveRequestHandler {
   void OnPreferenceChanged(const std::string& pref_name);
   void UpdateAdBlockFromPref(const std::string& pref_name);
 
+  // A pipeline stage along with the histogram its latency is recorded to.
+  template <typename Callback>
+  struct Stage {
+    base::HistogramBase* histogram;
+    Callback callback;
+  };
+
+  void AddBeforeURLRequestStage(const std::string& name,
+                                const brave::OnBeforeURLRequestCallback& cb);
+  void AddBeforeStartTransactionStage(
+      const std::string& name,
+      const brave::OnBeforeStartTransactionCallback& cb);
+  void AddHeadersReceivedStage(const std::string& name,
+                               const brave::OnHeadersReceivedCallback& cb);
+
+  // Starts the stages of |ctx->event_type|. Returns net::OK when all of them
+  // completed synchronously, in which case |callback| is never run.
+  int StartPipeline(std::shared_ptr<brave::BraveRequestInfo> ctx,
+                    net::CompletionOnceCallback callback);
+  size_t GetStageCount(brave::BraveNetworkDelegateEventType event_type) const;
+  base::HistogramBase* GetStageHistogram(
+      brave::BraveNetworkDelegateEventType event_type,
+      size_t index) const;
+  int RunStage(std::shared_ptr<brave::BraveRequestInfo> ctx,
+               size_t index,
+               const brave::ResponseCallback& next_callback);
+  // Runs stages until one of them goes pending or fails.
+  int RunStages(std::shared_ptr<brave::BraveRequestInfo> ctx);
+  void RecordStageTime(std::shared_ptr<brave::BraveRequestInfo> ctx,
+                       size_t index);
+  void OnStageComplete(std::shared_ptr<brave::BraveRequestInfo> ctx);
   void RunNextCallback(std::shared_ptr<brave::BraveRequestInfo> ctx);
+  void FinishPipeline(std::shared_ptr<brave::BraveRequestInfo> ctx, int rv);
 
-  std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks_;
-  std::vector<brave::OnBeforeStartTransactionCallback>
-      before_start_transaction_callbacks_;
-  std::vector<brave::OnHeadersReceivedCallback> headers_received_callbacks_;
+  std::vector<Stage<brave::OnBeforeURLRequestCallback>>
+      before_url_request_stages_;
+  std::vector<Stage<brave::OnBeforeStartTransactionCallback>>
+      before_start_transaction_stages_;
+  std::vector<Stage<brave::OnHeadersReceivedCallback>> headers_received_stages_;
 
   // TODO(iefremov): actually, we don't have to keep the list here, since
   // it is global for the whole browser and could live a singletonce in the
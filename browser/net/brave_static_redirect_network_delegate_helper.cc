@@ -8,6 +8,8 @@
 #include <memory>
 #include <vector>
 
+#include "base/no_destructor.h"
+#include "brave/browser/net/static_redirect_table.h"
 #include "brave/browser/translate/buildflags/buildflags.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/translate_network_constants.h"
@@ -27,133 +29,64 @@ int OnBeforeURLRequest_StaticRedirectWork(
   return rc;
 }
 
-int OnBeforeURLRequest_StaticRedirectWorkForGURL(
-    const GURL& request_url,
-    GURL* new_url) {
-  GURL::Replacements replacements;
-  static URLPattern geo_pattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern);
-  static URLPattern safeBrowsing_pattern(URLPattern::SCHEME_HTTPS,
-                                         kSafeBrowsingPrefix);
-  static URLPattern safebrowsingfilecheck_pattern(URLPattern::SCHEME_HTTPS,
-                                         kSafeBrowsingFileCheckPrefix);
-  static URLPattern crlSet_pattern1(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix1);
-  static URLPattern crlSet_pattern2(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix2);
-  static URLPattern crlSet_pattern3(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix3);
-  static URLPattern crlSet_pattern4(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix4);
-  static URLPattern crxDownload_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRXDownloadPrefix);
-  static URLPattern autofill_pattern(
-      URLPattern::SCHEME_HTTPS, kAutofillPrefix);
-  static URLPattern gvt1_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, "*://*.gvt1.com/*");
-  static URLPattern googleDl_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      "*://dl.google.com/*");
-
+namespace {
+
+std::vector<StaticRedirectTable::Entry> GetStaticRedirects() {
+  using Entry = StaticRedirectTable::Entry;
+  using Rewrite = StaticRedirectTable::Rewrite;
+  const int kHttpAndHttps = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+  Entry safebrowsing(URLPattern(URLPattern::SCHEME_HTTPS, kSafeBrowsingPrefix),
+                     Rewrite::kHost, SAFEBROWSING_ENDPOINT);
+  safebrowsing.match_host_only = true;
+  // TODO(@fmarier): Re-enable download protection once we have
+  // truncated the list of metadata that it sends to the server
+  // (brave/brave-browser#6267), by redirecting to
+  // kBraveSafeBrowsingFileCheckProxy.
+  Entry safebrowsing_file_check(
+      URLPattern(URLPattern::SCHEME_HTTPS, kSafeBrowsingFileCheckPrefix),
+      Rewrite::kNone);
+  safebrowsing_file_check.match_host_only = true;
+
+  return {
+      Entry(URLPattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern),
+            Rewrite::kURL, GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY),
+      safebrowsing,
+      safebrowsing_file_check,
+      Entry(URLPattern(kHttpAndHttps, kCRXDownloadPrefix), Rewrite::kHttpsHost,
+            "crxdownload.brave.com"),
+      Entry(URLPattern(URLPattern::SCHEME_HTTPS, kAutofillPrefix),
+            Rewrite::kHttpsHost, kBraveStaticProxy),
+      Entry(URLPattern(kHttpAndHttps, kCRLSetPrefix1), Rewrite::kHttpsHost,
+            "crlsets.brave.com"),
+      Entry(URLPattern(kHttpAndHttps, kCRLSetPrefix2), Rewrite::kHttpsHost,
+            "crlsets.brave.com"),
+      Entry(URLPattern(kHttpAndHttps, kCRLSetPrefix3), Rewrite::kHttpsHost,
+            "crlsets.brave.com"),
+      Entry(URLPattern(kHttpAndHttps, kCRLSetPrefix4), Rewrite::kHttpsHost,
+            "crlsets.brave.com"),
+      Entry(URLPattern(kHttpAndHttps, "*://*.gvt1.com/*"), Rewrite::kHttpsHost,
+            kBraveRedirectorProxy),
+      Entry(URLPattern(kHttpAndHttps, "*://dl.google.com/*"),
+            Rewrite::kHttpsHost, kBraveRedirectorProxy),
 #if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  static URLPattern translate_pattern(URLPattern::SCHEME_HTTPS,
-      kTranslateElementJSPattern);
-  static URLPattern translate_language_pattern(URLPattern::SCHEME_HTTPS,
-      kTranslateLanguagePattern);
+      Entry(URLPattern(URLPattern::SCHEME_HTTPS, kTranslateElementJSPattern),
+            Rewrite::kURLWithPathAndQuery, kBraveTranslateEndpoint),
+      Entry(URLPattern(URLPattern::SCHEME_HTTPS, kTranslateLanguagePattern),
+            Rewrite::kURL, kBraveTranslateLanguageEndpoint),
 #endif
-  if (geo_pattern.MatchesURL(request_url)) {
-    *new_url = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY);
-    return net::OK;
-  }
-
-  if (safeBrowsing_pattern.MatchesHost(request_url)) {
-    replacements.SetHostStr(SAFEBROWSING_ENDPOINT);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (safebrowsingfilecheck_pattern.MatchesHost(request_url)) {
-    // TODO(@fmarier): Re-enable download protection once we have
-    // truncated the list of metadata that it sends to the server
-    // (brave/brave-browser#6267).
-    //
-    // replacements.SetHostStr(kBraveSafeBrowsingFileCheckProxy);
-    // *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crxDownload_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crxdownload.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (autofill_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveStaticProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern1.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern2.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern3.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern4.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (gvt1_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (googleDl_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  if (translate_pattern.MatchesURL(request_url)) {
-    replacements.SetQueryStr(request_url.query_piece());
-    replacements.SetPathStr(request_url.path_piece());
-    *new_url =
-      GURL(kBraveTranslateEndpoint).ReplaceComponents(replacements);
-    return net::OK;
-  }
+  };
+}
 
-  if (translate_language_pattern.MatchesURL(request_url)) {
-    *new_url = GURL(kBraveTranslateLanguageEndpoint);
-    return net::OK;
-  }
-#endif
+}  // namespace
 
+int OnBeforeURLRequest_StaticRedirectWorkForGURL(
+    const GURL& request_url,
+    GURL* new_url) {
+  static const base::NoDestructor<StaticRedirectTable> redirects(
+      GetStaticRedirects());
+  redirects->Redirect(request_url, new_url);
   return net::OK;
 }
 
-
 }  // namespace brave
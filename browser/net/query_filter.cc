@@ -0,0 +1,98 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/query_filter.h"
+
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/optional.h"
+#include "base/strings/string_util.h"
+#include "base/values.h"
+
+namespace brave {
+
+QueryFilter::QueryFilter(const std::vector<std::string>& trackers) {
+  for (const std::string& tracker : trackers) {
+    if (!tracker.empty())
+      trackers_.insert(base::ToLowerASCII(tracker));
+  }
+}
+
+QueryFilter::QueryFilter(QueryFilter&& other) = default;
+
+QueryFilter& QueryFilter::operator=(QueryFilter&& other) = default;
+
+QueryFilter::~QueryFilter() = default;
+
+// static
+const QueryFilter& QueryFilter::GetDefault() {
+  static const base::NoDestructor<QueryFilter> filter(
+      std::vector<std::string>({"fbclid", "gclid", "msclkid", "mc_eid"}));
+  return *filter;
+}
+
+bool QueryFilter::Filter(base::StringPiece query,
+                         std::string* new_query) const {
+  DCHECK(new_query);
+  if (trackers_.empty())
+    return false;
+
+  std::string filtered_query;
+  bool filtered = false;
+  bool first = true;
+  // Walk the "&" separated parameters, keeping the separators of the
+  // parameters which are not removed, e.g. "&&" in "a=1&&fbclid=2" is kept as
+  // "a=1&".
+  size_t start = 0;
+  while (start <= query.size()) {
+    size_t end = query.find('&', start);
+    if (end == base::StringPiece::npos)
+      end = query.size();
+    const base::StringPiece parameter = query.substr(start, end - start);
+    if (IsTracker(parameter)) {
+      filtered = true;
+    } else {
+      if (!first)
+        filtered_query.push_back('&');
+      parameter.AppendToString(&filtered_query);
+      first = false;
+    }
+    start = end + 1;
+  }
+
+  if (filtered)
+    *new_query = std::move(filtered_query);
+  return filtered;
+}
+
+bool QueryFilter::IsTracker(base::StringPiece parameter) const {
+  const size_t equals = parameter.find('=');
+  // Parameters without a value are kept, e.g. "fbclid" or "fbclid="
+  if (equals == base::StringPiece::npos || equals + 1 == parameter.size())
+    return false;
+  return trackers_.count(base::ToLowerASCII(parameter.substr(0, equals))) > 0;
+}
+
+// static
+std::vector<std::string> QueryFilter::ParseTrackers(const std::string& json) {
+  std::vector<std::string> trackers;
+  base::Optional<base::Value> root = base::JSONReader::Read(json);
+  const base::Value* list =
+      root && root->is_dict() ? root->FindListKey("trackers") : nullptr;
+  if (!list) {
+    LOG(ERROR) << "Failed to parse query filter trackers";
+    return trackers;
+  }
+  for (const base::Value& tracker : list->GetList()) {
+    if (tracker.is_string())
+      trackers.push_back(tracker.GetString());
+  }
+  return trackers;
+}
+
+}  // namespace brave
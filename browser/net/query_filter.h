@@ -0,0 +1,53 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_QUERY_FILTER_H_
+#define BRAVE_BROWSER_NET_QUERY_FILTER_H_
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+namespace brave {
+
+// Removes the tracking parameters from query strings, e.g. "fbclid=1234". The
+// query is tokenized once and each parameter name is looked up in a hash set,
+// so the cost does not depend on the number of trackers.
+class QueryFilter {
+ public:
+  // |trackers| are the parameter names to remove, compared case-insensitively
+  explicit QueryFilter(const std::vector<std::string>& trackers);
+  QueryFilter(QueryFilter&& other);
+  QueryFilter& operator=(QueryFilter&& other);
+  ~QueryFilter();
+
+  // Returns the filter used until a tracker list has been delivered
+  static const QueryFilter& GetDefault();
+
+  // Returns whether tracking parameters with a value were found in |query|,
+  // in which case |new_query| is set to |query| without them. Parameters
+  // without a value are kept.
+  bool Filter(base::StringPiece query, std::string* new_query) const;
+
+  // Parses the trackers delivered by a component update:
+  // {"trackers": ["fbclid", "gclid", "utm_source"]}
+  static std::vector<std::string> ParseTrackers(const std::string& json);
+
+  size_t size() const { return trackers_.size(); }
+
+ private:
+  bool IsTracker(base::StringPiece parameter) const;
+
+  std::unordered_set<std::string> trackers_;
+
+  DISALLOW_COPY_AND_ASSIGN(QueryFilter);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_QUERY_FILTER_H_
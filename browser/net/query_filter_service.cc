@@ -0,0 +1,89 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/query_filter_service.h"
+
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/task/post_task.h"
+#include "base/task_runner_util.h"
+#include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_component_updater/browser/local_data_files_service.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+
+using content::BrowserThread;
+
+namespace brave {
+
+QueryFilterService::QueryFilterService(
+    LocalDataFilesService* local_data_files_service)
+    : LocalDataFilesObserver(local_data_files_service),
+      weak_factory_(this),
+      weak_factory_io_thread_(this) {}
+
+QueryFilterService::~QueryFilterService() {}
+
+bool QueryFilterService::Filter(base::StringPiece query,
+                                std::string* new_query) const {
+  const SharedQueryFilter* filter =
+      BrowserThread::CurrentlyOn(BrowserThread::IO)
+          ? query_filter_io_thread_.get()
+          : query_filter_.get();
+  return filter ? filter->data.Filter(query, new_query)
+                : QueryFilter::GetDefault().Filter(query, new_query);
+}
+
+void QueryFilterService::OnDATFileDataReady(std::string contents) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (contents.empty()) {
+    LOG(ERROR) << "Could not obtain query filter data";
+    return;
+  }
+  std::vector<std::string> trackers = QueryFilter::ParseTrackers(contents);
+  // Keep filtering the built-in trackers rather than none of them
+  if (trackers.empty())
+    return;
+  query_filter_ =
+      base::MakeRefCounted<SharedQueryFilter>(QueryFilter(trackers));
+
+  base::PostTask(
+      FROM_HERE, {BrowserThread::IO},
+      base::BindOnce(&QueryFilterService::OnDATFileDataReadyOnIOThread,
+                     weak_factory_io_thread_.GetWeakPtr(), query_filter_));
+}
+
+void QueryFilterService::OnDATFileDataReadyOnIOThread(
+    scoped_refptr<const SharedQueryFilter> filter) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  query_filter_io_thread_ = std::move(filter);
+}
+
+void QueryFilterService::OnComponentReady(const std::string& component_id,
+                                          const base::FilePath& install_dir,
+                                          const std::string& manifest) {
+  base::FilePath dat_file_path =
+      install_dir.AppendASCII(QUERY_FILTER_DAT_FILE_VERSION)
+          .AppendASCII(QUERY_FILTER_DAT_FILE);
+
+  base::PostTaskAndReplyWithResult(
+      local_data_files_service()->GetTaskRunner().get(), FROM_HERE,
+      base::BindOnce(&brave_component_updater::GetDATFileAsString,
+                     dat_file_path),
+      base::BindOnce(&QueryFilterService::OnDATFileDataReady,
+                     weak_factory_.GetWeakPtr()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+std::unique_ptr<QueryFilterService> QueryFilterServiceFactory(
+    LocalDataFilesService* local_data_files_service) {
+  return std::make_unique<QueryFilterService>(local_data_files_service);
+}
+
+}  // namespace brave
@@ -0,0 +1,67 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_QUERY_FILTER_SERVICE_H_
+#define BRAVE_BROWSER_NET_QUERY_FILTER_SERVICE_H_
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "base/strings/string_piece.h"
+#include "brave/browser/net/query_filter.h"
+#include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
+
+#define QUERY_FILTER_DAT_FILE "QueryFilter.json"
+#define QUERY_FILTER_DAT_FILE_VERSION "1"
+
+using brave_component_updater::LocalDataFilesObserver;
+using brave_component_updater::LocalDataFilesService;
+
+namespace brave {
+
+// The tracking query parameters delivered by component update, which replace
+// the built-in ones once loaded.
+class QueryFilterService : public LocalDataFilesObserver {
+ public:
+  explicit QueryFilterService(LocalDataFilesService* local_data_files_service);
+  ~QueryFilterService() override;
+
+  // See QueryFilter::Filter()
+  bool Filter(base::StringPiece query, std::string* new_query) const;
+
+  // implementation of LocalDataFilesObserver
+  void OnComponentReady(const std::string& component_id,
+                        const base::FilePath& install_dir,
+                        const std::string& manifest) override;
+
+ private:
+  // The filter is built once per DAT file update and then shared by the UI
+  // and IO threads, as it is never modified.
+  using SharedQueryFilter = base::RefCountedData<QueryFilter>;
+
+  void OnDATFileDataReady(std::string contents);
+  void OnDATFileDataReadyOnIOThread(
+      scoped_refptr<const SharedQueryFilter> filter);
+
+  scoped_refptr<const SharedQueryFilter> query_filter_;
+  scoped_refptr<const SharedQueryFilter> query_filter_io_thread_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+  base::WeakPtrFactory<QueryFilterService> weak_factory_;
+  base::WeakPtrFactory<QueryFilterService> weak_factory_io_thread_;
+  DISALLOW_COPY_AND_ASSIGN(QueryFilterService);
+};
+
+// Creates the QueryFilterService
+std::unique_ptr<QueryFilterService> QueryFilterServiceFactory(
+    LocalDataFilesService* local_data_files_service);
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_QUERY_FILTER_SERVICE_H_
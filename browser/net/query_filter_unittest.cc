@@ -0,0 +1,62 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/query_filter.h"
+
+#include <string>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+namespace {
+
+typedef testing::Test QueryFilterTest;
+
+}  // namespace
+
+TEST_F(QueryFilterTest, FiltersListedTrackers) {
+  QueryFilter filter({"utm_source", "UTM_Medium", "_hsenc"});
+
+  std::string new_query;
+  EXPECT_TRUE(filter.Filter("utm_source=a&foo=1&UTM_MEDIUM=b", &new_query));
+  EXPECT_EQ("foo=1", new_query);
+  EXPECT_TRUE(filter.Filter("foo=1&&_hsenc=x&", &new_query));
+  EXPECT_EQ("foo=1&&", new_query);
+  EXPECT_TRUE(filter.Filter("_hsenc=x", &new_query));
+  EXPECT_EQ("", new_query);
+
+  new_query = "unchanged";
+  EXPECT_FALSE(filter.Filter("utm_source=&utm_medium&fbclid=1", &new_query));
+  EXPECT_FALSE(filter.Filter("", &new_query));
+  EXPECT_EQ("unchanged", new_query);
+}
+
+TEST_F(QueryFilterTest, ParsesTrackers) {
+  EXPECT_EQ(std::vector<std::string>({"fbclid", "utm_source"}),
+            QueryFilter::ParseTrackers(
+                R"({"trackers": ["fbclid", 1, "utm_source"]})"));
+  EXPECT_TRUE(QueryFilter::ParseTrackers(R"(["fbclid"])").empty());
+  EXPECT_TRUE(QueryFilter::ParseTrackers("not json").empty());
+}
+
+TEST_F(QueryFilterTest, FiltersWithManyTrackers) {
+  std::vector<std::string> trackers;
+  for (int i = 0; i < 1000; ++i)
+    trackers.push_back("utm_" + base::NumberToString(i));
+  const QueryFilter large_filter(trackers);
+  const std::string query = "q=brave&utm_1=a&page=2&fbclid=1234&utm_999=b";
+
+  std::string new_query;
+  QueryFilter::GetDefault().Filter(query, &new_query);
+  EXPECT_EQ("q=brave&utm_1=a&page=2&utm_999=b", new_query);
+
+  large_filter.Filter(query, &new_query);
+  EXPECT_EQ("q=brave&page=2&fbclid=1234", new_query);
+}
+
+}  // namespace brave
@@ -0,0 +1,85 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/static_redirect_service.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/task/post_task.h"
+#include "base/task_runner_util.h"
+#include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_component_updater/browser/local_data_files_service.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "url/gurl.h"
+
+using content::BrowserThread;
+
+namespace brave {
+
+StaticRedirectService::StaticRedirectService(
+    LocalDataFilesService* local_data_files_service)
+    : LocalDataFilesObserver(local_data_files_service),
+      weak_factory_(this),
+      weak_factory_io_thread_(this) {}
+
+StaticRedirectService::~StaticRedirectService() {}
+
+bool StaticRedirectService::Redirect(const GURL& request_url,
+                                     GURL* new_url) const {
+  const RedirectTable* table = BrowserThread::CurrentlyOn(BrowserThread::IO)
+                                   ? redirect_table_io_thread_.get()
+                                   : redirect_table_.get();
+  return table && table->data.Redirect(request_url, new_url);
+}
+
+void StaticRedirectService::OnDATFileDataReady(std::string contents) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  redirect_table_ = nullptr;
+  if (contents.empty()) {
+    LOG(ERROR) << "Could not obtain static redirects data";
+  } else {
+    redirect_table_ = base::MakeRefCounted<RedirectTable>(
+        StaticRedirectTable(StaticRedirectTable::ParseEntries(contents)));
+  }
+
+  base::PostTask(
+      FROM_HERE, {BrowserThread::IO},
+      base::BindOnce(&StaticRedirectService::OnDATFileDataReadyOnIOThread,
+                     weak_factory_io_thread_.GetWeakPtr(), redirect_table_));
+}
+
+void StaticRedirectService::OnDATFileDataReadyOnIOThread(
+    scoped_refptr<const RedirectTable> table) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  redirect_table_io_thread_ = std::move(table);
+}
+
+void StaticRedirectService::OnComponentReady(
+    const std::string& component_id,
+    const base::FilePath& install_dir,
+    const std::string& manifest) {
+  base::FilePath dat_file_path =
+      install_dir.AppendASCII(STATIC_REDIRECTS_DAT_FILE_VERSION)
+          .AppendASCII(STATIC_REDIRECTS_DAT_FILE);
+
+  base::PostTaskAndReplyWithResult(
+      local_data_files_service()->GetTaskRunner().get(), FROM_HERE,
+      base::BindOnce(&brave_component_updater::GetDATFileAsString,
+                     dat_file_path),
+      base::BindOnce(&StaticRedirectService::OnDATFileDataReady,
+                     weak_factory_.GetWeakPtr()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+std::unique_ptr<StaticRedirectService> StaticRedirectServiceFactory(
+    LocalDataFilesService* local_data_files_service) {
+  return std::make_unique<StaticRedirectService>(local_data_files_service);
+}
+
+}  // namespace brave
@@ -0,0 +1,69 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_STATIC_REDIRECT_SERVICE_H_
+#define BRAVE_BROWSER_NET_STATIC_REDIRECT_SERVICE_H_
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "brave/browser/net/static_redirect_table.h"
+#include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
+
+#define STATIC_REDIRECTS_DAT_FILE "StaticRedirects.json"
+#define STATIC_REDIRECTS_DAT_FILE_VERSION "1"
+
+class GURL;
+
+using brave_component_updater::LocalDataFilesObserver;
+using brave_component_updater::LocalDataFilesService;
+
+namespace brave {
+
+// The static redirects delivered by component update, which are checked for
+// the requests not matched by the built-in redirects.
+class StaticRedirectService : public LocalDataFilesObserver {
+ public:
+  explicit StaticRedirectService(
+      LocalDataFilesService* local_data_files_service);
+  ~StaticRedirectService() override;
+
+  // Returns whether a redirect matches |request_url|, see
+  // StaticRedirectTable::Redirect().
+  bool Redirect(const GURL& request_url, GURL* new_url) const;
+
+  // implementation of LocalDataFilesObserver
+  void OnComponentReady(const std::string& component_id,
+                        const base::FilePath& install_dir,
+                        const std::string& manifest) override;
+
+ private:
+  // The table is compiled once per DAT file update and then shared by the UI
+  // and IO threads, as it is never modified.
+  using RedirectTable = base::RefCountedData<StaticRedirectTable>;
+
+  void OnDATFileDataReady(std::string contents);
+  void OnDATFileDataReadyOnIOThread(scoped_refptr<const RedirectTable> table);
+
+  scoped_refptr<const RedirectTable> redirect_table_;
+  scoped_refptr<const RedirectTable> redirect_table_io_thread_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+  base::WeakPtrFactory<StaticRedirectService> weak_factory_;
+  base::WeakPtrFactory<StaticRedirectService> weak_factory_io_thread_;
+  DISALLOW_COPY_AND_ASSIGN(StaticRedirectService);
+};
+
+// Creates the StaticRedirectService
+std::unique_ptr<StaticRedirectService> StaticRedirectServiceFactory(
+    LocalDataFilesService* local_data_files_service);
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_STATIC_REDIRECT_SERVICE_H_
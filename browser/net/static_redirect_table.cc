@@ -0,0 +1,168 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/static_redirect_table.h"
+
+#include <algorithm>
+
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/optional.h"
+#include "base/values.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "net/base/url_util.h"
+#include "url/gurl.h"
+#include "url/url_canon.h"
+#include "url/url_constants.h"
+
+namespace brave {
+
+namespace {
+
+// Entries delivered by component updates are checked for every request that
+// no built-in redirect matches, so they must be limited to the sites they
+// were written for: a pattern matching every host, or every subdomain of a
+// registry such as *.com, would redirect all traffic.
+bool IsAllowedComponentPattern(const URLPattern& pattern) {
+  if (pattern.match_all_urls() || pattern.host().empty())
+    return false;
+  if (pattern.match_subdomains() &&
+      !net::registry_controlled_domains::HostHasRegistryControlledDomain(
+          pattern.host(),
+          net::registry_controlled_domains::EXCLUDE_UNKNOWN_REGISTRIES,
+          net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES))
+    return false;
+  return true;
+}
+
+// The redirect target replaces the host of the request, so it has to be a
+// host in its canonical form or the resulting url would be invalid.
+bool IsCanonicalHost(const std::string& host) {
+  url::CanonHostInfo host_info;
+  return !host.empty() && net::CanonicalizeHost(host, &host_info) == host;
+}
+
+}  // namespace
+
+StaticRedirectTable::Entry::Entry(const URLPattern& pattern,
+                                  Rewrite rewrite,
+                                  const std::string& target)
+    : pattern(pattern), rewrite(rewrite), target(target) {}
+
+StaticRedirectTable::Entry::Entry(const Entry& other) = default;
+
+StaticRedirectTable::Entry::~Entry() = default;
+
+StaticRedirectTable::StaticRedirectTable() = default;
+
+StaticRedirectTable::StaticRedirectTable(const std::vector<Entry>& entries)
+    : entries_(entries) {
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    if (entries_[i].match_host_only) {
+      host_patterns_.Add(entries_[i].pattern);
+      host_pattern_entries_.push_back(i);
+    } else {
+      url_patterns_.Add(entries_[i].pattern);
+      url_pattern_entries_.push_back(i);
+    }
+  }
+}
+
+StaticRedirectTable::StaticRedirectTable(StaticRedirectTable&& other) =
+    default;
+
+StaticRedirectTable& StaticRedirectTable::operator=(
+    StaticRedirectTable&& other) = default;
+
+StaticRedirectTable::~StaticRedirectTable() = default;
+
+bool StaticRedirectTable::Redirect(const GURL& request_url,
+                                   GURL* new_url) const {
+  DCHECK(new_url);
+
+  base::Optional<size_t> index;
+  base::Optional<size_t> url_match = url_patterns_.GetFirstMatch(request_url);
+  if (url_match)
+    index = url_pattern_entries_[*url_match];
+  base::Optional<size_t> host_match =
+      host_patterns_.GetFirstHostMatch(request_url);
+  if (host_match)
+    index = std::min(index.value_or(entries_.size()),
+                     host_pattern_entries_[*host_match]);
+  if (!index)
+    return false;
+
+  const Entry& entry = entries_[*index];
+  GURL::Replacements replacements;
+  switch (entry.rewrite) {
+    case Rewrite::kNone:
+      break;
+    case Rewrite::kHost:
+      replacements.SetHostStr(entry.target);
+      *new_url = request_url.ReplaceComponents(replacements);
+      break;
+    case Rewrite::kHttpsHost:
+      replacements.SetSchemeStr(url::kHttpsScheme);
+      replacements.SetHostStr(entry.target);
+      *new_url = request_url.ReplaceComponents(replacements);
+      break;
+    case Rewrite::kURL:
+      *new_url = GURL(entry.target);
+      break;
+    case Rewrite::kURLWithQuery:
+      replacements.SetQueryStr(request_url.query_piece());
+      *new_url = GURL(entry.target).ReplaceComponents(replacements);
+      break;
+    case Rewrite::kURLWithPathAndQuery:
+      replacements.SetQueryStr(request_url.query_piece());
+      replacements.SetPathStr(request_url.path_piece());
+      *new_url = GURL(entry.target).ReplaceComponents(replacements);
+      break;
+  }
+  return true;
+}
+
+// static
+std::vector<StaticRedirectTable::Entry> StaticRedirectTable::ParseEntries(
+    const std::string& json) {
+  std::vector<Entry> entries;
+  base::Optional<base::Value> root = base::JSONReader::Read(json);
+  if (!root || !root->is_list()) {
+    LOG(ERROR) << "Failed to parse static redirects";
+    return entries;
+  }
+
+  for (const base::Value& item : root->GetList()) {
+    const std::string* pattern_string =
+        item.is_dict() ? item.FindStringKey("pattern") : nullptr;
+    if (!pattern_string)
+      continue;
+    URLPattern pattern(URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS);
+    if (pattern.Parse(*pattern_string) != URLPattern::ParseResult::kSuccess) {
+      LOG(ERROR) << "Malformed static redirect pattern: " << *pattern_string;
+      continue;
+    }
+    if (!IsAllowedComponentPattern(pattern)) {
+      LOG(ERROR) << "Static redirect pattern matches too many hosts: "
+                 << *pattern_string;
+      continue;
+    }
+
+    // Component updates can only redirect to https
+    if (const std::string* host = item.FindStringKey("host")) {
+      if (IsCanonicalHost(*host))
+        entries.emplace_back(pattern, Rewrite::kHttpsHost, *host);
+      else
+        LOG(ERROR) << "Invalid static redirect host: " << *host;
+    } else if (const std::string* url = item.FindStringKey("url")) {
+      GURL target(*url);
+      if (target.is_valid() && target.SchemeIs(url::kHttpsScheme))
+        entries.emplace_back(pattern, Rewrite::kURL, *url);
+    }
+  }
+  return entries;
+}
+
+}  // namespace brave
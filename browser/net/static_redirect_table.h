@@ -0,0 +1,87 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_STATIC_REDIRECT_TABLE_H_
+#define BRAVE_BROWSER_NET_STATIC_REDIRECT_TABLE_H_
+
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "brave/common/url_pattern_matcher.h"
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace brave {
+
+// Redirects for the requests matching URL patterns. The patterns are indexed
+// by host, so requests for other hosts are not checked against each of them.
+// When several entries match a request, the first one wins.
+class StaticRedirectTable {
+ public:
+  enum class Rewrite {
+    // The request is let through as is
+    kNone,
+    // The host of the request is replaced by |target|
+    kHost,
+    // The request is upgraded to https and its host replaced by |target|
+    kHttpsHost,
+    // The request is redirected to |target|
+    kURL,
+    // The request is redirected to |target| with the request's query
+    kURLWithQuery,
+    // The request is redirected to |target| with the request's path and query
+    kURLWithPathAndQuery,
+  };
+
+  struct Entry {
+    Entry(const URLPattern& pattern,
+          Rewrite rewrite,
+          const std::string& target = std::string());
+    Entry(const Entry& other);
+    ~Entry();
+
+    URLPattern pattern;
+    Rewrite rewrite;
+    // The host or url the request is redirected to, depending on |rewrite|
+    std::string target;
+    // Whether only the host of the request is matched against |pattern|
+    bool match_host_only = false;
+  };
+
+  StaticRedirectTable();
+  explicit StaticRedirectTable(const std::vector<Entry>& entries);
+  StaticRedirectTable(StaticRedirectTable&& other);
+  StaticRedirectTable& operator=(StaticRedirectTable&& other);
+  ~StaticRedirectTable();
+
+  // Returns whether an entry matches |request_url|, in which case |new_url|
+  // is set to the url it is redirected to, or left as is if the entry lets
+  // the request through.
+  bool Redirect(const GURL& request_url, GURL* new_url) const;
+
+  size_t size() const { return entries_.size(); }
+
+  // Parses the entries delivered by a component update, which redirect the
+  // matching requests to https and either a host or a url:
+  // [{"pattern": "*://*.example.com/*", "host": "redirector.brave.com"},
+  //  {"pattern": "https://example.com/a?*", "url": "https://brave.com/a"}]
+  static std::vector<Entry> ParseEntries(const std::string& json);
+
+ private:
+  std::vector<Entry> entries_;
+  URLPatternMatcher url_patterns_;
+  URLPatternMatcher host_patterns_;
+  // Indices in |entries_| of the patterns of each matcher
+  std::vector<size_t> url_pattern_entries_;
+  std::vector<size_t> host_pattern_entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(StaticRedirectTable);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_STATIC_REDIRECT_TABLE_H_
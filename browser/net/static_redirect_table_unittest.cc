@@ -0,0 +1,135 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/static_redirect_table.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+typedef testing::Test StaticRedirectTableTest;
+using Entry = StaticRedirectTable::Entry;
+using Rewrite = StaticRedirectTable::Rewrite;
+
+URLPattern Pattern(const std::string& pattern) {
+  return URLPattern(URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
+                    pattern);
+}
+
+}  // namespace
+
+TEST_F(StaticRedirectTableTest, AppliesRewrites) {
+  StaticRedirectTable table(
+      {Entry(Pattern("*://a.com/*"), Rewrite::kHttpsHost, "proxy.brave.com"),
+       Entry(Pattern("*://b.com/path?*"), Rewrite::kURLWithQuery,
+             "https://brave.com/updates"),
+       Entry(Pattern("*://c.com/*"), Rewrite::kURLWithPathAndQuery,
+             "https://translate.brave.com/"),
+       Entry(Pattern("*://d.com/*"), Rewrite::kNone)});
+
+  GURL new_url;
+  EXPECT_TRUE(table.Redirect(GURL("http://a.com/a?b"), &new_url));
+  EXPECT_EQ(GURL("https://proxy.brave.com/a?b"), new_url);
+  EXPECT_TRUE(table.Redirect(GURL("https://b.com/path?x=1"), &new_url));
+  EXPECT_EQ(GURL("https://brave.com/updates?x=1"), new_url);
+  EXPECT_TRUE(table.Redirect(GURL("https://c.com/a/b?x=1"), &new_url));
+  EXPECT_EQ(GURL("https://translate.brave.com/a/b?x=1"), new_url);
+
+  new_url = GURL();
+  EXPECT_TRUE(table.Redirect(GURL("https://d.com/"), &new_url));
+  EXPECT_TRUE(new_url.is_empty());
+  EXPECT_FALSE(table.Redirect(GURL("https://e.com/"), &new_url));
+  EXPECT_TRUE(new_url.is_empty());
+}
+
+TEST_F(StaticRedirectTableTest, FirstMatchingEntryWins) {
+  Entry host_entry(Pattern("*://*.a.com/only/this/path"), Rewrite::kHost,
+                   "host.brave.com");
+  host_entry.match_host_only = true;
+  StaticRedirectTable table(
+      {Entry(Pattern("*://www.a.com/first/*"), Rewrite::kURL,
+             "https://first.brave.com/"),
+       host_entry,
+       Entry(Pattern("*://*/*"), Rewrite::kURL, "https://last.brave.com/")});
+
+  GURL new_url;
+  EXPECT_TRUE(table.Redirect(GURL("https://www.a.com/first/a"), &new_url));
+  EXPECT_EQ(GURL("https://first.brave.com/"), new_url);
+  // Only the host is matched, so the path of the pattern is ignored
+  EXPECT_TRUE(table.Redirect(GURL("https://www.a.com/other"), &new_url));
+  EXPECT_EQ(GURL("https://host.brave.com/other"), new_url);
+  EXPECT_TRUE(table.Redirect(GURL("https://b.com/"), &new_url));
+  EXPECT_EQ(GURL("https://last.brave.com/"), new_url);
+}
+
+TEST_F(StaticRedirectTableTest, ParsesEntries) {
+  std::vector<Entry> entries = StaticRedirectTable::ParseEntries(R"([
+      {"pattern": "*://*.example.com/*", "host": "redirector.brave.com"},
+      {"pattern": "https://brave.com/a?*", "url": "https://brave.com/b"},
+      {"pattern": "https://brave.com/c", "url": "http://brave.com/d"},
+      {"pattern": "not a pattern", "host": "redirector.brave.com"},
+      {"host": "redirector.brave.com"}
+  ])");
+  ASSERT_EQ(2u, entries.size());
+  EXPECT_EQ(Rewrite::kHttpsHost, entries[0].rewrite);
+  EXPECT_EQ("redirector.brave.com", entries[0].target);
+  EXPECT_EQ(Rewrite::kURL, entries[1].rewrite);
+
+  StaticRedirectTable table(entries);
+  GURL new_url;
+  EXPECT_TRUE(table.Redirect(GURL("http://cdn.example.com/a"), &new_url));
+  EXPECT_EQ(GURL("https://redirector.brave.com/a"), new_url);
+
+  EXPECT_TRUE(StaticRedirectTable::ParseEntries("{}").empty());
+  EXPECT_TRUE(StaticRedirectTable::ParseEntries("not json").empty());
+}
+
+TEST_F(StaticRedirectTableTest, RejectsPatternsForAllHosts) {
+  EXPECT_TRUE(StaticRedirectTable::ParseEntries(R"([
+      {"pattern": "<all_urls>", "host": "redirector.brave.com"}
+  ])").empty());
+  EXPECT_TRUE(StaticRedirectTable::ParseEntries(R"([
+      {"pattern": "*://*/*", "host": "redirector.brave.com"}
+  ])").empty());
+  EXPECT_TRUE(StaticRedirectTable::ParseEntries(R"([
+      {"pattern": "https://*/a", "url": "https://brave.com/b"}
+  ])").empty());
+}
+
+TEST_F(StaticRedirectTableTest, RejectsPatternsForAllSubdomainsOfRegistry) {
+  EXPECT_TRUE(StaticRedirectTable::ParseEntries(R"([
+      {"pattern": "*://*.com/*", "host": "redirector.brave.com"}
+  ])").empty());
+  EXPECT_TRUE(StaticRedirectTable::ParseEntries(R"([
+      {"pattern": "*://*.co.uk/*", "host": "redirector.brave.com"}
+  ])").empty());
+  EXPECT_EQ(1u, StaticRedirectTable::ParseEntries(R"([
+      {"pattern": "*://*.example.co.uk/*", "host": "redirector.brave.com"}
+  ])").size());
+}
+
+TEST_F(StaticRedirectTableTest, RejectsInvalidHosts) {
+  EXPECT_TRUE(StaticRedirectTable::ParseEntries(R"([
+      {"pattern": "*://*.example.com/*", "host": ""}
+  ])").empty());
+  EXPECT_TRUE(StaticRedirectTable::ParseEntries(R"([
+      {"pattern": "*://*.example.com/*", "host": "redirector brave.com"}
+  ])").empty());
+  EXPECT_TRUE(StaticRedirectTable::ParseEntries(R"([
+      {"pattern": "*://*.example.com/*", "host": "brave.com/path"}
+  ])").empty());
+  // Only canonical hosts are accepted, not ones that would be rewritten.
+  EXPECT_TRUE(StaticRedirectTable::ParseEntries(R"([
+      {"pattern": "*://*.example.com/*", "host": "Redirector.Brave.com"}
+  ])").empty());
+}
+
+}  // namespace brave
@@ -8,40 +8,45 @@
 #include <memory>
 #include <string>
 
-#include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "brave/components/brave_shields/browser/shields_settings_snapshot.h"
 #include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
 #include "brave/components/brave_webtorrent/browser/webtorrent_util.h"
 #include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/browser_thread.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/resource_request_body.h"
 
 namespace brave {
 
-namespace {
-
-std::string GetUploadData(const network::ResourceRequest& request) {
-  std::string upload_data;
-  if (!request.request_body) {
-    return {};
-  }
-  const auto* elements = request.request_body->elements();
-  for (const network::DataElement& element : *elements) {
-    if (element.type() == network::mojom::DataElementType::kBytes) {
-      upload_data.append(element.bytes(), element.length());
-    }
-  }
-
-  return upload_data;
-}
-
-}  // namespace
-
 BraveRequestInfo::BraveRequestInfo() = default;
 
 BraveRequestInfo::BraveRequestInfo(const GURL& url) : request_url(url) {}
 
 BraveRequestInfo::~BraveRequestInfo() = default;
 
+const std::string& BraveRequestInfo::GetUploadData() {
+  if (upload_data)
+    return *upload_data;
+
+  upload_data.emplace();
+  if (!request_body)
+    return *upload_data;
+
+  size_t length = 0;
+  for (const network::DataElement& element : *request_body->elements()) {
+    if (element.type() == network::mojom::DataElementType::kBytes)
+      length += element.length();
+  }
+  upload_data->reserve(length);
+  for (const network::DataElement& element : *request_body->elements()) {
+    if (element.type() == network::mojom::DataElementType::kBytes)
+      upload_data->append(element.bytes(), element.length());
+  }
+  request_body = nullptr;
+  return *upload_data;
+}
+
 // static
 void BraveRequestInfo::FillCTX(const network::ResourceRequest& request,
                                int render_process_id,
@@ -92,16 +97,16 @@ void BraveRequestInfo::FillCTX(const network::ResourceRequest& request,
                               .GetOrigin();
   }
 
-  Profile* profile = Profile::FromBrowserContext(browser_context);
-  ctx->allow_brave_shields =
-      brave_shields::GetBraveShieldsEnabled(profile, ctx->tab_origin);
-  ctx->allow_ads = brave_shields::GetAdControlType(profile, ctx->tab_origin) ==
-                   brave_shields::ControlType::ALLOW;
+  const brave_shields::ShieldsSettingsSnapshot& shields_settings =
+      brave_shields::GetShieldsSettingsSnapshot(
+          Profile::FromBrowserContext(browser_context), ctx->tab_origin);
+  ctx->allow_brave_shields = shields_settings.brave_shields_enabled;
+  ctx->allow_ads = shields_settings.allow_ads;
   ctx->allow_http_upgradable_resource =
-      !brave_shields::GetHTTPSEverywhereEnabled(profile, ctx->tab_origin);
-  ctx->allow_referrers =
-      brave_shields::AllowReferrers(profile, ctx->tab_origin);
-  ctx->upload_data = GetUploadData(request);
+      !shields_settings.https_everywhere_enabled;
+  ctx->allow_referrers = shields_settings.allow_referrers;
+  ctx->request_body = request.request_body;
+  ctx->upload_data.reset();
 }
 
 }  // namespace brave
@@ -10,6 +10,9 @@
 #include <set>
 #include <string>
 
+#include "base/memory/scoped_refptr.h"
+#include "base/optional.h"
+#include "base/time/time.h"
 #include "content/public/common/resource_type.h"
 #include "net/url_request/url_request.h"
 #include "url/gurl.h"
@@ -21,6 +24,7 @@ class BrowserContext;
 }
 
 namespace network {
+class ResourceRequestBody;
 struct ResourceRequest;
 }
 
@@ -100,7 +104,10 @@ struct BraveRequestInfo {
       static_cast<content::ResourceType>(-1);
   content::ResourceType resource_type = kInvalidResourceType;
 
-  std::string upload_data;
+  // Returns the bytes elements of the request body. The body is shared with
+  // the request and only copied the first time this is called, so it should
+  // only be called by the helpers which need it for this particular request.
+  const std::string& GetUploadData();
 
   static void FillCTX(const network::ResourceRequest& request,
                       int render_process_id,
@@ -115,6 +122,10 @@ struct BraveRequestInfo {
   friend class ::BraveRequestHandler;
 
   GURL* new_url = nullptr;
+  scoped_refptr<network::ResourceRequestBody> request_body;
+  base::Optional<std::string> upload_data;
+  // When the currently running pipeline stage was started.
+  base::TimeTicks stage_start_time;
 
   DISALLOW_COPY_AND_ASSIGN(BraveRequestInfo);
 };
@@ -6,10 +6,14 @@
 #ifndef BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 #define BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 
+// |brave_rules_version| is assigned a new value each time the rules are
+// received by a renderer, so that rules compiled from them can be reused
+// until the next update.
 #define BRAVE_CONTENT_SETTINGS_H                  \
   ContentSettingsForOneType autoplay_rules;       \
   ContentSettingsForOneType fingerprinting_rules; \
-  ContentSettingsForOneType brave_shields_rules;
+  ContentSettingsForOneType brave_shields_rules;  \
+  int brave_rules_version = 0;
 
 #include "../../../../../../components/content_settings/core/common/content_settings.h"
 
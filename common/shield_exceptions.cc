@@ -5,71 +5,60 @@
 
 #include "brave/common/shield_exceptions.h"
 
-#include <algorithm>
-#include <map>
 #include <vector>
 
+#include "base/no_destructor.h"
+#include "brave/common/url_pattern_matcher.h"
 #include "extensions/common/url_pattern.h"
 #include "url/gurl.h"
 
 namespace brave {
 
+namespace {
+
+SubresourceURLPatternMatcher CreateFingerprintingExceptions() {
+  SubresourceURLPatternMatcher exceptions;
+  exceptions.Add(
+      URLPattern(URLPattern::SCHEME_ALL, "https://*.1password.com/*"),
+      {URLPattern(URLPattern::SCHEME_ALL,
+                  "https://map.1passwordservices.com/*")});
+  exceptions.Add(
+      URLPattern(URLPattern::SCHEME_ALL, "https://sandbox.uphold.com/"),
+      {URLPattern(URLPattern::SCHEME_ALL, "https://*.netverify.com/*"),
+       URLPattern(URLPattern::SCHEME_ALL, "https://*.veriff.me/*")});
+  exceptions.Add(
+      URLPattern(URLPattern::SCHEME_ALL, "https://uphold.com/"),
+      {URLPattern(URLPattern::SCHEME_ALL, "https://uphold.netverify.com/*"),
+       URLPattern(URLPattern::SCHEME_ALL, "https://*.veriff.me/*")});
+  return exceptions;
+}
+
+}  // namespace
+
 bool IsUAWhitelisted(const GURL& gurl) {
-  static std::vector<URLPattern> whitelist_patterns({
-    URLPattern(URLPattern::SCHEME_ALL, "https://*.adobe.com/*"),
-    URLPattern(URLPattern::SCHEME_ALL, "https://*.duckduckgo.com/*"),
-    URLPattern(URLPattern::SCHEME_ALL, "https://*.brave.com/*"),
-    // For Widevine
-    URLPattern(URLPattern::SCHEME_ALL, "https://*.netflix.com/*")
-  });
-  return std::any_of(whitelist_patterns.begin(), whitelist_patterns.end(),
-      [&gurl](URLPattern pattern){
-        return pattern.MatchesURL(gurl);
-      });
+  static const base::NoDestructor<URLPatternMatcher> whitelist_patterns(
+      std::vector<URLPattern>({
+          URLPattern(URLPattern::SCHEME_ALL, "https://*.adobe.com/*"),
+          URLPattern(URLPattern::SCHEME_ALL, "https://*.duckduckgo.com/*"),
+          URLPattern(URLPattern::SCHEME_ALL, "https://*.brave.com/*"),
+          // For Widevine
+          URLPattern(URLPattern::SCHEME_ALL, "https://*.netflix.com/*")}));
+  return whitelist_patterns->MatchesURL(gurl);
 }
 
 bool IsBlockedResource(const GURL& gurl) {
-  static std::vector<URLPattern> blocked_patterns({
-      URLPattern(URLPattern::SCHEME_ALL, "https://pdfjs.robwu.nl/*")
-  });
-  return std::any_of(blocked_patterns.begin(), blocked_patterns.end(),
-                     [&gurl](URLPattern pattern){
-                       return pattern.MatchesURL(gurl);
-                     });
+  static const base::NoDestructor<URLPatternMatcher> blocked_patterns(
+      std::vector<URLPattern>({
+          URLPattern(URLPattern::SCHEME_ALL, "https://pdfjs.robwu.nl/*")}));
+  return blocked_patterns->MatchesURL(gurl);
 }
 
 bool IsWhitelistedFingerprintingException(const GURL& firstPartyOrigin,
     const GURL& subresourceUrl) {
-  static std::map<URLPattern, std::vector<URLPattern> > whitelist_patterns = {
-    {
-      URLPattern(URLPattern::SCHEME_ALL, "https://uphold.com/"),
-      std::vector<URLPattern>({
-        URLPattern(URLPattern::SCHEME_ALL, "https://uphold.netverify.com/*"),
-        URLPattern(URLPattern::SCHEME_ALL, "https://*.veriff.me/*"),
-      })
-    },
-    {
-      URLPattern(URLPattern::SCHEME_ALL, "https://sandbox.uphold.com/"),
-      std::vector<URLPattern>({
-        URLPattern(URLPattern::SCHEME_ALL, "https://*.netverify.com/*"),
-        URLPattern(URLPattern::SCHEME_ALL, "https://*.veriff.me/*"),
-      })
-    },
-    {
-      URLPattern(URLPattern::SCHEME_ALL, "https://*.1password.com/*"),
-      std::vector<URLPattern>({URLPattern(URLPattern::SCHEME_ALL,
-            "https://map.1passwordservices.com/*")})
-    }
-  };
-  for (const auto whitelist : whitelist_patterns) {
-      if (whitelist.first.MatchesURL(firstPartyOrigin)) {
-          return std::any_of(whitelist.second.begin(), whitelist.second.end(),
-            [&subresourceUrl](const URLPattern& pattern) {
-              return pattern.MatchesURL(subresourceUrl);
-          });
-      }
-  }
-  return false;
+  // Only the first matching first party pattern applies
+  static const base::NoDestructor<SubresourceURLPatternMatcher> exceptions(
+      CreateFingerprintingExceptions());
+  return exceptions->MatchesFirst(firstPartyOrigin, subresourceUrl);
 }
 
 }  // namespace brave
@@ -0,0 +1,153 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/common/url_pattern_matcher.h"
+
+#include <algorithm>
+
+#include "base/strings/string_piece.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+// URLPattern ignores the trailing dot of hosts
+base::StringPiece TrimTrailingDot(base::StringPiece host) {
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+  return host;
+}
+
+}  // namespace
+
+URLPatternMatcher::URLPatternMatcher() = default;
+
+URLPatternMatcher::URLPatternMatcher(const std::vector<URLPattern>& patterns) {
+  patterns_.reserve(patterns.size());
+  for (const URLPattern& pattern : patterns)
+    Add(pattern);
+}
+
+URLPatternMatcher::URLPatternMatcher(URLPatternMatcher&& other) = default;
+
+URLPatternMatcher& URLPatternMatcher::operator=(URLPatternMatcher&& other) =
+    default;
+
+URLPatternMatcher::~URLPatternMatcher() = default;
+
+size_t URLPatternMatcher::Add(const URLPattern& pattern) {
+  const size_t index = patterns_.size();
+  patterns_.push_back(pattern);
+
+  const std::string host = TrimTrailingDot(pattern.host()).as_string();
+  if (host.empty())
+    wildcard_patterns_.push_back(index);
+  else if (pattern.match_subdomains())
+    patterns_by_domain_[host].push_back(index);
+  else
+    patterns_by_host_[host].push_back(index);
+  return index;
+}
+
+bool URLPatternMatcher::MatchesURL(const GURL& url) const {
+  return GetFirstMatch(url).has_value();
+}
+
+base::Optional<size_t> URLPatternMatcher::GetFirstMatch(
+    const GURL& url) const {
+  for (size_t index : GetCandidates(url)) {
+    if (patterns_[index].MatchesURL(url))
+      return index;
+  }
+  return base::nullopt;
+}
+
+std::vector<size_t> URLPatternMatcher::GetMatches(const GURL& url) const {
+  std::vector<size_t> matches;
+  for (size_t index : GetCandidates(url)) {
+    if (patterns_[index].MatchesURL(url))
+      matches.push_back(index);
+  }
+  return matches;
+}
+
+base::Optional<size_t> URLPatternMatcher::GetFirstHostMatch(
+    const GURL& url) const {
+  for (size_t index : GetCandidates(url)) {
+    if (patterns_[index].MatchesHost(url))
+      return index;
+  }
+  return base::nullopt;
+}
+
+URLPatternMatcher::PatternIndices URLPatternMatcher::GetCandidates(
+    const GURL& url) const {
+  PatternIndices candidates(wildcard_patterns_);
+
+  // URLPattern matches filesystem urls against their inner url
+  const GURL& inner_url = url.inner_url() ? *url.inner_url() : url;
+  base::StringPiece host = TrimTrailingDot(inner_url.host_piece());
+  if (!host.empty()) {
+    auto it = patterns_by_host_.find(host.as_string());
+    if (it != patterns_by_host_.end()) {
+      candidates.insert(candidates.end(), it->second.begin(),
+                        it->second.end());
+    }
+
+    // Walk up the domain, e.g. a.b.com, b.com and com
+    while (true) {
+      it = patterns_by_domain_.find(host.as_string());
+      if (it != patterns_by_domain_.end()) {
+        candidates.insert(candidates.end(), it->second.begin(),
+                          it->second.end());
+      }
+      const size_t dot = host.find('.');
+      if (dot == base::StringPiece::npos)
+        break;
+      host.remove_prefix(dot + 1);
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  return candidates;
+}
+
+SubresourceURLPatternMatcher::SubresourceURLPatternMatcher() = default;
+
+SubresourceURLPatternMatcher::SubresourceURLPatternMatcher(
+    SubresourceURLPatternMatcher&& other) = default;
+
+SubresourceURLPatternMatcher& SubresourceURLPatternMatcher::operator=(
+    SubresourceURLPatternMatcher&& other) = default;
+
+SubresourceURLPatternMatcher::~SubresourceURLPatternMatcher() = default;
+
+void SubresourceURLPatternMatcher::Add(
+    const URLPattern& first_party_pattern,
+    const std::vector<URLPattern>& subresource_patterns) {
+  first_party_patterns_.Add(first_party_pattern);
+  subresource_patterns_.emplace_back(subresource_patterns);
+}
+
+bool SubresourceURLPatternMatcher::MatchesAny(
+    const GURL& first_party_url,
+    const GURL& subresource_url) const {
+  for (size_t index : first_party_patterns_.GetMatches(first_party_url)) {
+    if (subresource_patterns_[index].MatchesURL(subresource_url))
+      return true;
+  }
+  return false;
+}
+
+bool SubresourceURLPatternMatcher::MatchesFirst(
+    const GURL& first_party_url,
+    const GURL& subresource_url) const {
+  base::Optional<size_t> index =
+      first_party_patterns_.GetFirstMatch(first_party_url);
+  return index && subresource_patterns_[*index].MatchesURL(subresource_url);
+}
+
+}  // namespace brave
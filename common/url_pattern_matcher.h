@@ -0,0 +1,104 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMMON_URL_PATTERN_MATCHER_H_
+#define BRAVE_COMMON_URL_PATTERN_MATCHER_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/optional.h"
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace brave {
+
+// URLPatterns indexed by host, so that matching a url only checks the
+// patterns which can match its host: the patterns for the host itself, the
+// subdomain patterns for the domains it belongs to, and the patterns which
+// match any host.
+class URLPatternMatcher {
+ public:
+  URLPatternMatcher();
+  explicit URLPatternMatcher(const std::vector<URLPattern>& patterns);
+  URLPatternMatcher(URLPatternMatcher&& other);
+  URLPatternMatcher& operator=(URLPatternMatcher&& other);
+  ~URLPatternMatcher();
+
+  // Adds |pattern| and returns its index, which is the number of patterns
+  // added before it.
+  size_t Add(const URLPattern& pattern);
+
+  bool MatchesURL(const GURL& url) const;
+
+  // Returns the index of the first added pattern which matches |url|.
+  base::Optional<size_t> GetFirstMatch(const GURL& url) const;
+
+  // Returns the indices of the patterns matching |url|, in the order they
+  // were added.
+  std::vector<size_t> GetMatches(const GURL& url) const;
+
+  // Like GetFirstMatch(), but only the host of |url| is matched, as in
+  // URLPattern::MatchesHost().
+  base::Optional<size_t> GetFirstHostMatch(const GURL& url) const;
+
+  size_t size() const { return patterns_.size(); }
+
+ private:
+  using PatternIndices = std::vector<size_t>;
+
+  // Returns the indices of the patterns which can match |url|, sorted.
+  PatternIndices GetCandidates(const GURL& url) const;
+
+  std::vector<URLPattern> patterns_;
+  // Patterns which only match their host
+  std::unordered_map<std::string, PatternIndices> patterns_by_host_;
+  // Patterns which match their host and its subdomains
+  std::unordered_map<std::string, PatternIndices> patterns_by_domain_;
+  // Patterns which match any host
+  PatternIndices wildcard_patterns_;
+
+  DISALLOW_COPY_AND_ASSIGN(URLPatternMatcher);
+};
+
+// Subresource patterns which apply to the pages matching a first party
+// pattern, e.g. whitelists of third party resources.
+class SubresourceURLPatternMatcher {
+ public:
+  SubresourceURLPatternMatcher();
+  SubresourceURLPatternMatcher(SubresourceURLPatternMatcher&& other);
+  SubresourceURLPatternMatcher& operator=(
+      SubresourceURLPatternMatcher&& other);
+  ~SubresourceURLPatternMatcher();
+
+  void Add(const URLPattern& first_party_pattern,
+           const std::vector<URLPattern>& subresource_patterns);
+
+  // Returns whether |subresource_url| matches the subresource patterns of any
+  // of the first party patterns matching |first_party_url|.
+  bool MatchesAny(const GURL& first_party_url,
+                  const GURL& subresource_url) const;
+
+  // Returns whether |subresource_url| matches the subresource patterns of the
+  // first added first party pattern matching |first_party_url|.
+  bool MatchesFirst(const GURL& first_party_url,
+                    const GURL& subresource_url) const;
+
+  size_t size() const { return first_party_patterns_.size(); }
+
+ private:
+  URLPatternMatcher first_party_patterns_;
+  // Indexed like |first_party_patterns_|
+  std::vector<URLPatternMatcher> subresource_patterns_;
+
+  DISALLOW_COPY_AND_ASSIGN(SubresourceURLPatternMatcher);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_COMMON_URL_PATTERN_MATCHER_H_
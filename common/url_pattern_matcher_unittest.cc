@@ -0,0 +1,139 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/common/url_pattern_matcher.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+typedef testing::Test URLPatternMatcherTest;
+
+URLPattern Pattern(const std::string& pattern) {
+  return URLPattern(URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
+                    pattern);
+}
+
+}  // namespace
+
+TEST_F(URLPatternMatcherTest, MatchesByHost) {
+  URLPatternMatcher matcher({Pattern("https://*.brave.com/*"),
+                             Pattern("https://example.com/path/*"),
+                             Pattern("http://*/*")});
+
+  EXPECT_TRUE(matcher.MatchesURL(GURL("https://brave.com/")));
+  EXPECT_TRUE(matcher.MatchesURL(GURL("https://a.b.brave.com/")));
+  EXPECT_FALSE(matcher.MatchesURL(GURL("https://notbrave.com/")));
+  EXPECT_TRUE(matcher.MatchesURL(GURL("https://example.com/path/a")));
+  EXPECT_FALSE(matcher.MatchesURL(GURL("https://example.com/other")));
+  EXPECT_FALSE(matcher.MatchesURL(GURL("https://www.example.com/path/a")));
+  EXPECT_TRUE(matcher.MatchesURL(GURL("http://test.com/")));
+  EXPECT_FALSE(matcher.MatchesURL(GURL("https://test.com/")));
+}
+
+TEST_F(URLPatternMatcherTest, ReturnsMatchesInOrder) {
+  URLPatternMatcher matcher;
+  EXPECT_EQ(0u, matcher.Add(Pattern("https://*/*")));
+  EXPECT_EQ(1u, matcher.Add(Pattern("https://www.brave.com/*")));
+  EXPECT_EQ(2u, matcher.Add(Pattern("https://*.brave.com/*")));
+  EXPECT_EQ(3u, matcher.Add(Pattern("https://*.example.com/*")));
+
+  EXPECT_EQ(std::vector<size_t>({0, 1, 2}),
+            matcher.GetMatches(GURL("https://www.brave.com/")));
+  EXPECT_EQ(0u, *matcher.GetFirstMatch(GURL("https://www.brave.com/")));
+  EXPECT_EQ(std::vector<size_t>({0, 3}),
+            matcher.GetMatches(GURL("https://example.com/")));
+  EXPECT_FALSE(matcher.GetFirstMatch(GURL("http://www.brave.com/")));
+}
+
+TEST_F(URLPatternMatcherTest, MatchesSubresourcePatterns) {
+  SubresourceURLPatternMatcher matcher;
+  matcher.Add(Pattern("https://*.brave.com/*"),
+              {Pattern("https://cdn.example.com/*")});
+  matcher.Add(Pattern("https://www.brave.com/*"),
+              {Pattern("https://*.tracker.com/*")});
+
+  const GURL first_party_url("https://www.brave.com/");
+  EXPECT_TRUE(
+      matcher.MatchesAny(first_party_url, GURL("https://cdn.example.com/")));
+  EXPECT_TRUE(
+      matcher.MatchesAny(first_party_url, GURL("https://a.tracker.com/")));
+  EXPECT_FALSE(
+      matcher.MatchesAny(GURL("https://brave.com/"),
+                         GURL("https://a.tracker.com/")));
+  EXPECT_TRUE(
+      matcher.MatchesFirst(first_party_url, GURL("https://cdn.example.com/")));
+  EXPECT_FALSE(
+      matcher.MatchesFirst(first_party_url, GURL("https://a.tracker.com/")));
+  EXPECT_FALSE(
+      matcher.MatchesAny(GURL("https://test.com/"),
+                         GURL("https://cdn.example.com/")));
+}
+
+// Checks pairs of urls, a tenth of which are whitelisted, against many first
+// party patterns and compares with scanning the patterns.
+TEST_F(URLPatternMatcherTest, MatchesLikeScanningPatterns) {
+  const int kFirstPartyCount = 50;
+  const int kSubresourcesPerFirstParty = 3;
+  const int kLookupCount = 500;
+
+  std::vector<std::pair<URLPattern, std::vector<URLPattern>>> whitelist;
+  SubresourceURLPatternMatcher matcher;
+  for (int i = 0; i < kFirstPartyCount; ++i) {
+    const std::string site = "site" + base::NumberToString(i) + ".com";
+    std::vector<URLPattern> subresource_patterns;
+    for (int j = 0; j < kSubresourcesPerFirstParty; ++j) {
+      subresource_patterns.push_back(Pattern(
+          "https://*.cdn" + base::NumberToString(j) + "." + site + "/*"));
+    }
+    whitelist.emplace_back(Pattern("https://*." + site + "/*"),
+                           subresource_patterns);
+    matcher.Add(whitelist.back().first, whitelist.back().second);
+  }
+
+  std::vector<std::pair<GURL, GURL>> lookups;
+  for (int i = 0; i < kLookupCount; ++i) {
+    const std::string site =
+        "site" + base::NumberToString(i % kFirstPartyCount) + ".com";
+    lookups.emplace_back(
+        GURL("https://www." + site + "/"),
+        GURL(i % 10 ? "https://tracker.com/a.js"
+                    : "https://a.cdn0." + site + "/a.js"));
+  }
+
+  int scan_matches = 0;
+  for (const auto& lookup : lookups) {
+    for (const auto& entry : whitelist) {
+      if (entry.first.MatchesURL(lookup.first) &&
+          std::any_of(entry.second.begin(), entry.second.end(),
+                      [&lookup](const URLPattern& pattern) {
+                        return pattern.MatchesURL(lookup.second);
+                      })) {
+        ++scan_matches;
+        break;
+      }
+    }
+  }
+
+  int matches = 0;
+  for (const auto& lookup : lookups) {
+    if (matcher.MatchesAny(lookup.first, lookup.second))
+      ++matches;
+  }
+
+  EXPECT_EQ(kLookupCount / 10, matches);
+  EXPECT_EQ(scan_matches, matches);
+}
+
+}  // namespace brave
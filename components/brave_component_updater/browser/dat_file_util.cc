@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 
+#include <memory>
 #include <string>
 
 #include "base/logging.h"
@@ -44,4 +45,16 @@ std::string GetDATFileAsString(const base::FilePath& file_path) {
   return contents;
 }
 
+std::unique_ptr<base::MemoryMappedFile> MapDATFile(
+    const base::FilePath& file_path) {
+  auto mapping = std::make_unique<base::MemoryMappedFile>();
+  if (!mapping->Initialize(file_path) || 0 == mapping->length()) {
+    LOG(ERROR) << "MapDATFile: "
+               << "the dat file is not found or corrupted "
+               << file_path;
+    return nullptr;
+  }
+  return mapping;
+}
+
 }  // namespace brave_component_updater
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
 
 namespace brave_component_updater {
 
@@ -20,6 +21,15 @@ using DATFileDataBuffer = std::vector<unsigned char>;
 void GetDATFileData(const base::FilePath& file_path,
                     DATFileDataBuffer* buffer);
 std::string GetDATFileAsString(const base::FilePath& file_path);
+// Maps |file_path| read-only, so its pages are only read in when touched and
+// come from the page cache shared with other processes. Returns nullptr if the
+// file can't be mapped or is empty. Must be called where blocking is allowed,
+// and the mapping released there too.
+std::unique_ptr<base::MemoryMappedFile> MapDATFile(
+    const base::FilePath& file_path);
+
+// For parsers which take a mutable pointer and reference the DAT data in
+// place; the buffer must outlive the client.
 
 template<typename T>
 using LoadDATFileDataResult =
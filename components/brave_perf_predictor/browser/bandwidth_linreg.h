@@ -6,6 +6,9 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_LINREG_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_LINREG_H_
 
+#include <stddef.h>
+
+#include <array>
 #include <string>
 #include <vector>
 
@@ -14,6 +17,29 @@
 
 namespace brave_perf_predictor {
 
+namespace internal {
+
+constexpr bool FeatureNameEquals(const char* a, const char* b) {
+  while (*a && *a == *b) {
+    ++a;
+    ++b;
+  }
+  return *a == *b;
+}
+
+}  // namespace internal
+
+// Returns the position of the feature |name| in the feature vector, or
+// feature_count if the model does not use it. Meant to be evaluated at compile
+// time, e.g. constexpr size_t kIndex = FeatureIndex("adblockRequests");
+constexpr size_t FeatureIndex(const char* name) {
+  for (size_t i = 0; i < feature_sequence.size(); i++) {
+    if (internal::FeatureNameEquals(feature_sequence[i], name))
+      return i;
+  }
+  return feature_sequence.size();
+}
+
 // Computes prediction based on the provided feature vector.
 // It is the client's responsibility to provide features in
 // the exact order expected by the predictor.
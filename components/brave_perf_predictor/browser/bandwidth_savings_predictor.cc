@@ -5,7 +5,15 @@
 
 #include "brave/components/brave_perf_predictor/browser/bandwidth_savings_predictor.h"
 
+#include <utility>
+#include <vector>
+
+#include "base/containers/flat_map.h"
 #include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/stl_util.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 #include "components/page_load_metrics/common/page_load_metrics.mojom.h"
@@ -15,6 +23,77 @@
 
 namespace brave_perf_predictor {
 
+namespace {
+
+#define DECLARE_FEATURE_INDEX(NAME, FEATURE)     \
+  constexpr size_t NAME = FeatureIndex(FEATURE); \
+  static_assert(NAME < feature_sequence.size(), FEATURE " is not a feature")
+
+DECLARE_FEATURE_INDEX(kAdblockRequests, "adblockRequests");
+DECLARE_FEATURE_INDEX(kFirstMeaningfulPaint, "metrics.firstMeaningfulPaint");
+DECLARE_FEATURE_INDEX(kInteractive, "metrics.interactive");
+DECLARE_FEATURE_INDEX(kObservedDomContentLoaded,
+                      "metrics.observedDomContentLoaded");
+DECLARE_FEATURE_INDEX(kObservedFirstVisualChange,
+                      "metrics.observedFirstVisualChange");
+DECLARE_FEATURE_INDEX(kObservedLoad, "metrics.observedLoad");
+DECLARE_FEATURE_INDEX(kDocumentRequestCount,
+                      "resources.document.requestCount");
+DECLARE_FEATURE_INDEX(kDocumentSize, "resources.document.size");
+DECLARE_FEATURE_INDEX(kFontRequestCount, "resources.font.requestCount");
+DECLARE_FEATURE_INDEX(kFontSize, "resources.font.size");
+DECLARE_FEATURE_INDEX(kImageRequestCount, "resources.image.requestCount");
+DECLARE_FEATURE_INDEX(kImageSize, "resources.image.size");
+DECLARE_FEATURE_INDEX(kMediaRequestCount, "resources.media.requestCount");
+DECLARE_FEATURE_INDEX(kMediaSize, "resources.media.size");
+DECLARE_FEATURE_INDEX(kOtherRequestCount, "resources.other.requestCount");
+DECLARE_FEATURE_INDEX(kOtherSize, "resources.other.size");
+DECLARE_FEATURE_INDEX(kScriptRequestCount, "resources.script.requestCount");
+DECLARE_FEATURE_INDEX(kScriptSize, "resources.script.size");
+DECLARE_FEATURE_INDEX(kStylesheetRequestCount,
+                      "resources.stylesheet.requestCount");
+DECLARE_FEATURE_INDEX(kStylesheetSize, "resources.stylesheet.size");
+DECLARE_FEATURE_INDEX(kThirdPartyRequestCount,
+                      "resources.third-party.requestCount");
+DECLARE_FEATURE_INDEX(kThirdPartySize, "resources.third-party.size");
+DECLARE_FEATURE_INDEX(kTotalRequestCount, "resources.total.requestCount");
+DECLARE_FEATURE_INDEX(kTotalSize, "resources.total.size");
+
+#undef DECLARE_FEATURE_INDEX
+
+constexpr char kThirdPartyFeaturePrefix[] = "thirdParties.";
+constexpr char kThirdPartyFeatureSuffix[] = ".blocked";
+
+// Returns the index of the "thirdParties.<name>.blocked" feature of each third
+// party used by the model
+base::flat_map<std::string, size_t> GetThirdPartyBlockedFeatureIndices() {
+  std::vector<std::pair<std::string, size_t>> indices;
+  for (size_t i = 0; i < feature_sequence.size(); i++) {
+    base::StringPiece feature(feature_sequence[i]);
+    if (!base::StartsWith(feature, kThirdPartyFeaturePrefix,
+                          base::CompareCase::SENSITIVE) ||
+        !base::EndsWith(feature, kThirdPartyFeatureSuffix,
+                        base::CompareCase::SENSITIVE)) {
+      continue;
+    }
+    feature.remove_prefix(base::size(kThirdPartyFeaturePrefix) - 1);
+    feature.remove_suffix(base::size(kThirdPartyFeatureSuffix) - 1);
+    indices.emplace_back(feature.as_string(), i);
+  }
+  return base::flat_map<std::string, size_t>(std::move(indices));
+}
+
+// Returns the index of the feature of |third_party| being blocked, or
+// feature_count if the model does not use it
+size_t GetThirdPartyBlockedFeatureIndex(const std::string& third_party) {
+  static const base::NoDestructor<base::flat_map<std::string, size_t>> indices(
+      GetThirdPartyBlockedFeatureIndices());
+  const auto it = indices->find(third_party);
+  return it != indices->end() ? it->second : feature_sequence.size();
+}
+
+}  // namespace
+
 BandwidthSavingsPredictor::BandwidthSavingsPredictor() = default;
 
 BandwidthSavingsPredictor::~BandwidthSavingsPredictor() = default;
@@ -23,41 +102,44 @@ void BandwidthSavingsPredictor::OnPageLoadTimingUpdated(
     const page_load_metrics::mojom::PageLoadTiming& timing) {
   // First meaningful paint
   if (timing.paint_timing->first_meaningful_paint.has_value())
-    feature_map_["metrics.firstMeaningfulPaint"] =
+    features_[kFirstMeaningfulPaint] =
         timing.paint_timing->first_meaningful_paint.value().InMillisecondsF();
 
   // DOM Content Loaded
   if (timing.document_timing->dom_content_loaded_event_start.has_value())
-    feature_map_["metrics.observedDomContentLoaded"] =
+    features_[kObservedDomContentLoaded] =
         timing.document_timing->dom_content_loaded_event_start.value()
             .InMillisecondsF();
 
   // First contentful paint
   if (timing.paint_timing->first_contentful_paint.has_value())
-    feature_map_["metrics.observedFirstVisualChange"] =
+    features_[kObservedFirstVisualChange] =
         timing.paint_timing->first_contentful_paint.value().InMillisecondsF();
 
   // Load
   if (timing.document_timing->load_event_start.has_value())
-    feature_map_["metrics.observedLoad"] =
+    features_[kObservedLoad] =
         timing.document_timing->load_event_start.value().InMillisecondsF();
 
   // Interactive
   if (timing.interactive_timing->interactive.has_value())
-    feature_map_["metrics.interactive"] =
+    features_[kInteractive] =
         timing.interactive_timing->interactive.value().InMillisecondsF();
 }
 
 void BandwidthSavingsPredictor::OnSubresourceBlocked(
     const std::string& resource_url) {
-  feature_map_["adblockRequests"] += 1;
+  features_[kAdblockRequests] += 1;
 
   const NamedThirdPartyRegistry* tp_registry =
       NamedThirdPartyRegistry::GetInstance();
   if (tp_registry) {
     const auto tp_name = tp_registry->GetThirdParty(resource_url);
-    if (tp_name.has_value())
-      feature_map_["thirdParties." + tp_name.value() + ".blocked"] = 1;
+    if (tp_name.has_value()) {
+      const size_t index = GetThirdPartyBlockedFeatureIndex(tp_name.value());
+      if (index < features_.size())
+        features_[index] = 1;
+    }
   }
 }
 
@@ -78,45 +160,49 @@ void BandwidthSavingsPredictor::OnResourceLoadComplete(
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
   if (is_third_party) {
-    feature_map_["resources.third-party.requestCount"] += 1;
-    feature_map_["resources.third-party.size"] +=
+    features_[kThirdPartyRequestCount] += 1;
+    features_[kThirdPartySize] +=
         resource_load_info.raw_body_bytes;
   }
 
-  feature_map_["resources.total.requestCount"] += 1;
-  feature_map_["resources.total.size"] += resource_load_info.raw_body_bytes;
-  feature_map_["transfer.total.size"] +=
-      resource_load_info.total_received_bytes;
-  std::string resource_type;
+  features_[kTotalRequestCount] += 1;
+  features_[kTotalSize] += resource_load_info.raw_body_bytes;
+  transfer_total_size_ += resource_load_info.total_received_bytes;
+  size_t request_count_index;
+  size_t size_index;
   switch (resource_load_info.resource_type) {
     case content::ResourceType::kMainFrame:
-      resource_type = "document";
-      break;
     case content::ResourceType::kSubFrame:
-      resource_type = "document";
+      request_count_index = kDocumentRequestCount;
+      size_index = kDocumentSize;
       break;
     case content::ResourceType::kStylesheet:
-      resource_type = "stylesheet";
+      request_count_index = kStylesheetRequestCount;
+      size_index = kStylesheetSize;
       break;
     case content::ResourceType::kScript:
-      resource_type = "script";
+      request_count_index = kScriptRequestCount;
+      size_index = kScriptSize;
       break;
     case content::ResourceType::kImage:
-      resource_type = "image";
+      request_count_index = kImageRequestCount;
+      size_index = kImageSize;
       break;
     case content::ResourceType::kFontResource:
-      resource_type = "font";
+      request_count_index = kFontRequestCount;
+      size_index = kFontSize;
       break;
     case content::ResourceType::kMedia:
-      resource_type = "media";
+      request_count_index = kMediaRequestCount;
+      size_index = kMediaSize;
       break;
     default:
-      resource_type = "other";
+      request_count_index = kOtherRequestCount;
+      size_index = kOtherSize;
       break;
   }
-  feature_map_["resources." + resource_type + ".requestCount"] += 1;
-  feature_map_["resources." + resource_type + ".size"] +=
-      resource_load_info.raw_body_bytes;
+  features_[request_count_index] += 1;
+  features_[size_index] += resource_load_info.raw_body_bytes;
 }
 
 double BandwidthSavingsPredictor::PredictSavingsBytes() const {
@@ -124,30 +210,30 @@ double BandwidthSavingsPredictor::PredictSavingsBytes() const {
       !main_frame_url_.SchemeIsHTTPOrHTTPS()) {
     return 0;
   }
-  const auto total_size = feature_map_.find("transfer.total.size");
-  if (total_size != feature_map_.end() && total_size->second > 0) {
-    VLOG(2) << main_frame_url_ << " total download size " << total_size->second
-            << " bytes";
+  if (transfer_total_size_ > 0) {
+    VLOG(2) << main_frame_url_ << " total download size "
+            << transfer_total_size_ << " bytes";
   }
 
   // Short-circuit if nothing got blocked
-  const auto adblock_requests = feature_map_.find("adblockRequests");
-  if (adblock_requests == feature_map_.end() || adblock_requests->second < 1) {
+  if (features_[kAdblockRequests] < 1) {
     return 0;
   }
   if (VLOG_IS_ON(3)) {
-    VLOG(3) << "Predicting on feature map:";
-    for (const auto& feature : feature_map_) {
-      VLOG(3) << feature.first << " :: " << feature.second;
+    VLOG(3) << "Predicting on features:";
+    for (size_t i = 0; i < feature_sequence.size(); i++) {
+      if (features_[i] != 0)
+        VLOG(3) << feature_sequence[i] << " :: " << features_[i];
     }
   }
-  double prediction = ::brave_perf_predictor::LinregPredictNamed(feature_map_);
+  double prediction = ::brave_perf_predictor::LinregPredictVector(features_);
   VLOG(2) << main_frame_url_ << " estimated saving " << prediction << " bytes";
   return prediction;
 }
 
 void BandwidthSavingsPredictor::Reset() {
-  feature_map_.clear();
+  features_.fill(0);
+  transfer_total_size_ = 0;
   main_frame_url_ = {};
 }
 
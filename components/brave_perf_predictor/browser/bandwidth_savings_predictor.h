@@ -6,10 +6,11 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_SAVINGS_PREDICTOR_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_SAVINGS_PREDICTOR_H_
 
+#include <array>
 #include <string>
 
-#include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 #include "url/gurl.h"
 
 namespace page_load_metrics {
@@ -62,7 +63,10 @@ class BandwidthSavingsPredictor {
                            FeaturiseResourceLoading);
 
   GURL main_frame_url_;
-  base::flat_map<std::string, double> feature_map_;
+  // Features in the order expected by the model, see FeatureIndex()
+  std::array<double, feature_count> features_{};
+  // Not a feature of the model, only logged
+  double transfer_total_size_ = 0;
 };
 
 }  // namespace brave_perf_predictor
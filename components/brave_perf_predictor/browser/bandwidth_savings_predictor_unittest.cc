@@ -5,8 +5,9 @@
 
 #include "brave/components/brave_perf_predictor/browser/bandwidth_savings_predictor.h"
 
-#include "base/containers/flat_map.h"
 #include "base/time/time.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
+#include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 #include "chrome/browser/predictors/loading_test_util.h"
 #include "components/page_load_metrics/common/page_load_metrics.mojom.h"
 #include "components/page_load_metrics/common/page_load_timing.h"
@@ -17,55 +18,70 @@
 namespace brave_perf_predictor {
 
 TEST(BandwidthSavingsPredictorTest, FeaturiseBlocked) {
+  NamedThirdPartyRegistry::GetInstance()->InitializeDefaultForTesting();
   BandwidthSavingsPredictor predictor;
   predictor.OnSubresourceBlocked("https://google-analytics.com");
-  EXPECT_EQ(predictor.feature_map_["adblockRequests"], 1);
-  EXPECT_EQ(predictor.feature_map_["thirdParties.Google Analytics.blocked"],
-            1);
+  EXPECT_EQ(predictor.features_[FeatureIndex("adblockRequests")], 1);
+  EXPECT_EQ(
+      predictor.features_[FeatureIndex(
+          "thirdParties.Google Analytics.blocked")],
+      1);
   predictor.OnSubresourceBlocked("https://test.m.facebook.com");
-  EXPECT_EQ(predictor.feature_map_["adblockRequests"], 2);
+  EXPECT_EQ(predictor.features_[FeatureIndex("adblockRequests")], 2);
 }
 
 TEST(BandwidthSavingsPredictorTest, FeaturiseTiming) {
   BandwidthSavingsPredictor predictor;
   const auto empty_timing = page_load_metrics::CreatePageLoadTiming();
   predictor.OnPageLoadTimingUpdated(*empty_timing);
-  EXPECT_EQ(predictor.feature_map_["metrics.firstMeaningfulPaint"], 0);
-  EXPECT_EQ(predictor.feature_map_["metrics.observedDomContentLoaded"], 0);
-  EXPECT_EQ(predictor.feature_map_["metrics.observedFirstVisualChange"], 0);
-  EXPECT_EQ(predictor.feature_map_["metrics.observedLoad"], 0);
-  EXPECT_EQ(predictor.feature_map_["metrics.interactive"], 0);
+  EXPECT_EQ(predictor.features_[FeatureIndex("metrics.firstMeaningfulPaint")],
+            0);
+  EXPECT_EQ(
+      predictor.features_[FeatureIndex("metrics.observedDomContentLoaded")],
+      0);
+  EXPECT_EQ(
+      predictor.features_[FeatureIndex("metrics.observedFirstVisualChange")],
+      0);
+  EXPECT_EQ(predictor.features_[FeatureIndex("metrics.observedLoad")], 0);
+  EXPECT_EQ(predictor.features_[FeatureIndex("metrics.interactive")], 0);
 
   auto timing = page_load_metrics::CreatePageLoadTiming();
   timing->document_timing->dom_content_loaded_event_start =
       base::TimeDelta::FromMilliseconds(1000);
   predictor.OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor.feature_map_["metrics.observedDomContentLoaded"], 1000);
+  EXPECT_EQ(
+      predictor.features_[FeatureIndex("metrics.observedDomContentLoaded")],
+      1000);
 
   timing->document_timing->load_event_start =
       base::TimeDelta::FromMilliseconds(2000);
   predictor.OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor.feature_map_["metrics.observedLoad"], 2000);
+  EXPECT_EQ(predictor.features_[FeatureIndex("metrics.observedLoad")], 2000);
 
   timing->paint_timing->first_meaningful_paint =
       base::TimeDelta::FromMilliseconds(1500);
   predictor.OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor.feature_map_["metrics.firstMeaningfulPaint"], 1500);
+  EXPECT_EQ(predictor.features_[FeatureIndex("metrics.firstMeaningfulPaint")],
+            1500);
 
   timing->paint_timing->first_contentful_paint =
       base::TimeDelta::FromMilliseconds(800);
   predictor.OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor.feature_map_["metrics.observedFirstVisualChange"], 800);
+  EXPECT_EQ(
+      predictor.features_[FeatureIndex("metrics.observedFirstVisualChange")],
+      800);
 
   timing->interactive_timing->interactive =
       base::TimeDelta::FromMilliseconds(2500);
   predictor.OnPageLoadTimingUpdated(*timing);
-  EXPECT_EQ(predictor.feature_map_["metrics.interactive"], 2500);
+  EXPECT_EQ(predictor.features_[FeatureIndex("metrics.interactive")], 2500);
 }
 
 TEST(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
   BandwidthSavingsPredictor predictor;
-  EXPECT_EQ(predictor.feature_map_["resources.third-party.requestCount"], 0);
+  EXPECT_EQ(
+      predictor.features_[FeatureIndex("resources.third-party.requestCount")],
+      0);
 
   const GURL main_frame("https://brave.com/");
 
@@ -73,9 +89,14 @@ TEST(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
       "https://brave.com/style.css", content::ResourceType::kStylesheet);
   fp_style->raw_body_bytes = 1000;
   predictor.OnResourceLoadComplete(main_frame, *fp_style);
-  EXPECT_EQ(predictor.feature_map_["resources.third-party.requestCount"], 0);
-  EXPECT_EQ(predictor.feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor.feature_map_["resources.stylesheet.size"], 1000);
+  EXPECT_EQ(
+      predictor.features_[FeatureIndex("resources.third-party.requestCount")],
+      0);
+  EXPECT_EQ(
+      predictor.features_[FeatureIndex("resources.stylesheet.requestCount")],
+      1);
+  EXPECT_EQ(predictor.features_[FeatureIndex("resources.stylesheet.size")],
+            1000);
 
   auto tp_style = predictors::CreateResourceLoadInfo(
       "https://stackpath.bootstrapcdn.com/bootstrap/4.4.1/css/bootstrap.min.js",
@@ -83,14 +104,21 @@ TEST(BandwidthSavingsPredictorTest, FeaturiseResourceLoading) {
   tp_style->raw_body_bytes = 1001;
   predictor.OnResourceLoadComplete(main_frame, *tp_style);
 
-  EXPECT_EQ(predictor.feature_map_["resources.third-party.requestCount"], 1);
-  EXPECT_EQ(predictor.feature_map_["resources.stylesheet.requestCount"], 1);
-  EXPECT_EQ(predictor.feature_map_["resources.script.requestCount"], 1);
-  EXPECT_EQ(predictor.feature_map_["resources.stylesheet.size"], 1000);
-  EXPECT_EQ(predictor.feature_map_["resources.script.size"], 1001);
+  EXPECT_EQ(
+      predictor.features_[FeatureIndex("resources.third-party.requestCount")],
+      1);
+  EXPECT_EQ(
+      predictor.features_[FeatureIndex("resources.stylesheet.requestCount")],
+      1);
+  EXPECT_EQ(predictor.features_[FeatureIndex("resources.script.requestCount")],
+            1);
+  EXPECT_EQ(predictor.features_[FeatureIndex("resources.stylesheet.size")],
+            1000);
+  EXPECT_EQ(predictor.features_[FeatureIndex("resources.script.size")], 1001);
 
-  EXPECT_EQ(predictor.feature_map_["resources.total.requestCount"], 2);
-  EXPECT_EQ(predictor.feature_map_["resources.total.size"], 2001);
+  EXPECT_EQ(predictor.features_[FeatureIndex("resources.total.requestCount")],
+            2);
+  EXPECT_EQ(predictor.features_[FeatureIndex("resources.total.size")], 2001);
 }
 
 TEST(BandwidthSavingsPredictorTest, PredictZeroNoData) {
@@ -133,6 +161,7 @@ TEST(BandwidthSavingsPredictorTest, PredictZeroNoBlocks) {
 }
 
 TEST(BandwidthSavingsPredictorTest, PredictNonZero) {
+  NamedThirdPartyRegistry::GetInstance()->InitializeDefaultForTesting();
   BandwidthSavingsPredictor predictor;
 
   const GURL main_frame("https://brave.com");
@@ -5,12 +5,17 @@
 
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 
+#include <utility>
+
+#include "base/bind.h"
 #include "base/containers/flat_set.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
+#include "base/task/post_task.h"
+#include "base/task_runner_util.h"
 #include "base/values.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 #include "components/grit/brave_components_resources.h"
@@ -20,34 +25,73 @@
 
 namespace brave_perf_predictor {
 
+NamedThirdPartyRegistry::Mappings::Mappings() = default;
+
+NamedThirdPartyRegistry::Mappings::Mappings(Mappings&& other) = default;
+
+NamedThirdPartyRegistry::Mappings& NamedThirdPartyRegistry::Mappings::
+operator=(Mappings&& other) = default;
+
+NamedThirdPartyRegistry::Mappings::~Mappings() = default;
+
 // static
 NamedThirdPartyRegistry* NamedThirdPartyRegistry::GetInstance() {
-  auto* extractor = base::Singleton<NamedThirdPartyRegistry>::get();
-  // By default initialize from packaged resources
-  if (!extractor->IsInitialized()) {
-    bool initialized = extractor->InitializeFromResource();
-    if (!initialized) {
-      VLOG(2) << "Initialization from resource failed, marking as initialized "
-              << "will not retry";
-      extractor->MarkInitialized(true);
-    }
-  }
-  return extractor;
+  return base::Singleton<NamedThirdPartyRegistry>::get();
+}
+
+void NamedThirdPartyRegistry::InitializeDefault() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (initialized_)
+    return;
+  initialized_ = true;
+
+  // Parsing the packaged entities takes long enough to be noticeable during
+  // a page load
+  base::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::ThreadPool(), base::TaskPriority::BEST_EFFORT,
+       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+      base::BindOnce(&NamedThirdPartyRegistry::ParseMappingsFromResource),
+      base::BindOnce(&NamedThirdPartyRegistry::OnMappingsParsed,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void NamedThirdPartyRegistry::InitializeDefaultForTesting() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  initialized_ = true;
+  base::Optional<Mappings> mappings = ParseMappingsFromResource();
+  if (mappings)
+    mappings_ = std::move(*mappings);
+  mappings_loaded_ = true;
 }
 
 bool NamedThirdPartyRegistry::LoadMappings(const base::StringPiece entities,
                                            bool discard_irrelevant) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  base::Optional<Mappings> mappings =
+      ParseMappings(entities, discard_irrelevant);
   // Reset previous mappings
-  entity_by_domain_.clear();
-  entity_by_root_domain_.clear();
+  mappings_ = mappings ? std::move(*mappings) : Mappings();
+  initialized_ = true;
+  mappings_loaded_ = true;
+  return mappings.has_value();
+}
 
+// static
+base::Optional<NamedThirdPartyRegistry::Mappings>
+NamedThirdPartyRegistry::ParseMappings(const base::StringPiece entities,
+                                       bool discard_irrelevant) {
   // Parse the JSON
   base::Optional<base::Value> document = base::JSONReader::Read(entities);
   if (!document || !document->is_list()) {
     LOG(ERROR) << "Cannot parse the third-party entities list";
-    return false;
+    return base::nullopt;
   }
 
+  Mappings mappings;
+  auto& entity_by_domain = mappings.entity_by_domain;
+  auto& entity_by_root_domain = mappings.entity_by_root_domain;
+
   // Collect the mappings
   for (auto& entity : document->GetList()) {
     const std::string* entity_name = entity.FindStringPath("name");
@@ -68,7 +112,7 @@ bool NamedThirdPartyRegistry::LoadMappings(const base::StringPiece entities,
       const base::StringPiece entity_domain(entity_domain_it.GetString());
 
       const auto inserted =
-          entity_by_domain_.emplace(entity_domain, *entity_name);
+          entity_by_domain.emplace(entity_domain, *entity_name);
       if (!inserted.second) {
         VLOG(2) << "Malformed data: duplicate domain " << entity_domain;
       }
@@ -76,42 +120,41 @@ bool NamedThirdPartyRegistry::LoadMappings(const base::StringPiece entities,
           entity_domain,
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
-      auto root_entity_entry = entity_by_root_domain_.find(root_domain);
-      if (root_entity_entry != entity_by_root_domain_.end() &&
+      auto root_entity_entry = entity_by_root_domain.find(root_domain);
+      if (root_entity_entry != entity_by_root_domain.end() &&
           root_entity_entry->second != *entity_name) {
         // If there is a clash at root domain level, neither is correct
-        entity_by_root_domain_.erase(root_entity_entry);
+        entity_by_root_domain.erase(root_entity_entry);
       } else {
-        entity_by_root_domain_.emplace(root_domain, *entity_name);
+        entity_by_root_domain.emplace(root_domain, *entity_name);
       }
     }
   }
 
-  entity_by_domain_.shrink_to_fit();
-  entity_by_root_domain_.shrink_to_fit();
-  VLOG(2) << "Loaded " << entity_by_domain_.size() << " mappings by domain and "
-          << entity_by_root_domain_.size() << " by root domain; size";
-  initialized_ = true;
-
-  return true;
+  entity_by_domain.shrink_to_fit();
+  entity_by_root_domain.shrink_to_fit();
+  VLOG(2) << "Loaded " << entity_by_domain.size() << " mappings by domain and "
+          << entity_by_root_domain.size() << " by root domain; size";
+  return mappings;
 }
 
 base::Optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
     const base::StringPiece request_url) const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   const GURL url(request_url);
   if (!url.is_valid())
     return base::nullopt;
 
   if (url.has_host()) {
-    auto domain_entry = entity_by_domain_.find(url.host());
-    if (domain_entry != entity_by_domain_.end())
+    auto domain_entry = mappings_.entity_by_domain.find(url.host());
+    if (domain_entry != mappings_.entity_by_domain.end())
       return domain_entry->second;
 
     auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
         url, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
-    auto root_domain_entry = entity_by_root_domain_.find(root_domain);
-    if (root_domain_entry != entity_by_root_domain_.end())
+    auto root_domain_entry = mappings_.entity_by_root_domain.find(root_domain);
+    if (root_domain_entry != mappings_.entity_by_root_domain.end())
       return root_domain_entry->second;
   }
 
@@ -122,7 +165,9 @@ NamedThirdPartyRegistry::NamedThirdPartyRegistry() = default;
 
 NamedThirdPartyRegistry::~NamedThirdPartyRegistry() = default;
 
-bool NamedThirdPartyRegistry::InitializeFromResource() {
+// static
+base::Optional<NamedThirdPartyRegistry::Mappings>
+NamedThirdPartyRegistry::ParseMappingsFromResource() {
   const auto resource_id = IDR_THIRD_PARTY_ENTITIES;
   // TODO(AndriusA): insert trace event here
   SCOPED_UMA_HISTOGRAM_TIMER(
@@ -131,7 +176,22 @@ bool NamedThirdPartyRegistry::InitializeFromResource() {
   std::string data_resource =
       resource_bundle.LoadDataResourceString(resource_id);
   // Parse resource, discarding irrelevant entities
-  return LoadMappings(data_resource, true);
+  return ParseMappings(data_resource, true);
+}
+
+void NamedThirdPartyRegistry::OnMappingsParsed(
+    base::Optional<Mappings> mappings) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (mappings_loaded_) {
+    VLOG(2) << "Mappings loaded while parsing the resource, keeping them";
+    return;
+  }
+  if (!mappings) {
+    VLOG(2) << "Initialization from resource failed, will not retry";
+    return;
+  }
+  mappings_ = std::move(*mappings);
+  mappings_loaded_ = true;
 }
 
 }  // namespace brave_perf_predictor
@@ -10,7 +10,10 @@
 
 #include "base/containers/flat_map.h"
 #include "base/memory/singleton.h"
-#include "base/values.h"
+#include "base/memory/weak_ptr.h"
+#include "base/optional.h"
+#include "base/sequence_checker.h"
+#include "base/strings/string_piece.h"
 
 namespace brave_perf_predictor {
 
@@ -23,6 +26,12 @@ class NamedThirdPartyRegistry {
   NamedThirdPartyRegistry& operator=(const NamedThirdPartyRegistry&) = delete;
   static NamedThirdPartyRegistry* GetInstance();
 
+  // Starts loading the packaged mappings on a background thread, unless they
+  // are already loaded or being loaded. Until then no third party is found.
+  void InitializeDefault();
+  // Loads the packaged mappings synchronously.
+  void InitializeDefaultForTesting();
+
   // Parse the provided mappings (in JSON format), potentially discarding
   // entities not relevant to the bandwith prediction model (i.e. those not
   // seen in training the model).
@@ -33,17 +42,36 @@ class NamedThirdPartyRegistry {
 
  private:
   friend struct base::DefaultSingletonTraits<NamedThirdPartyRegistry>;
+  friend class NamedThirdPartyRegistryInitializeTest;
+
+  struct Mappings {
+    Mappings();
+    Mappings(Mappings&& other);
+    Mappings& operator=(Mappings&& other);
+    ~Mappings();
+
+    base::flat_map<std::string, std::string> entity_by_domain;
+    base::flat_map<std::string, std::string> entity_by_root_domain;
+  };
 
   NamedThirdPartyRegistry();
   ~NamedThirdPartyRegistry();
 
-  bool IsInitialized() const { return initialized_; }
-  void MarkInitialized(bool initialized) { initialized_ = initialized; }
-  bool InitializeFromResource();
+  static base::Optional<Mappings> ParseMappings(
+      const base::StringPiece entities,
+      bool discard_irrelevant);
+  static base::Optional<Mappings> ParseMappingsFromResource();
+  void OnMappingsParsed(base::Optional<Mappings> mappings);
 
+  // Whether the mappings are loaded, or being loaded on a background thread
   bool initialized_ = false;
-  base::flat_map<std::string, std::string> entity_by_domain_;
-  base::flat_map<std::string, std::string> entity_by_root_domain_;
+  // Whether |mappings_| holds loaded mappings, which a parse of the resource
+  // finishing later must not replace
+  bool mappings_loaded_ = false;
+  Mappings mappings_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+  base::WeakPtrFactory<NamedThirdPartyRegistry> weak_factory_{this};
 };
 
 }  // namespace brave_perf_predictor
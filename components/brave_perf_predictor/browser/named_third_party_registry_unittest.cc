@@ -7,6 +7,7 @@
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/test/task_environment.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace brave_perf_predictor {
@@ -53,7 +54,19 @@ std::string LoadFile() {
 
 }  // namespace
 
-TEST(NamedThirdPartyRegistryTest, HandlesEmptyJSON) {
+// Uses its own registry rather than the singleton, which the other tests have
+// already loaded mappings into.
+class NamedThirdPartyRegistryInitializeTest : public ::testing::Test {
+ protected:
+  NamedThirdPartyRegistry* registry() { return &registry_; }
+
+  base::test::TaskEnvironment task_environment_;
+
+ private:
+  NamedThirdPartyRegistry registry_;
+};
+
+NamedThirdPartyRegistryTest, HandlesEmptyJSON) {
   NamedThirdPartyRegistry* extractor = NamedThirdPartyRegistry::GetInstance();
   bool parsed = extractor->LoadMappings("", false);
   EXPECT_FALSE(parsed);
@@ -114,4 +127,29 @@ TEST(NamedThirdPartyRegistryTest, HandlesUnrecognisedThirdPartyTest) {
   EXPECT_FALSE(entity.has_value());
 }
 
+TEST_F(NamedThirdPartyRegistryInitializeTest, LoadsDefaultInBackground) {
+  registry()->InitializeDefault();
+  EXPECT_FALSE(
+      registry()->GetThirdParty("https://google-analytics.com/ga.js"));
+
+  task_environment_.RunUntilIdle();
+  auto entity =
+      registry()->GetThirdParty("https://google-analytics.com/ga.js");
+  ASSERT_TRUE(entity.has_value());
+  EXPECT_EQ(entity.value(), "Google Analytics");
+}
+
+TEST_F(NamedThirdPartyRegistryInitializeTest, KeepsMappingsLoadedMeanwhile) {
+  registry()->InitializeDefault();
+  EXPECT_TRUE(registry()->LoadMappings(
+      R"([{"name":"Example","domains":["example.com"]}])", false));
+
+  task_environment_.RunUntilIdle();
+  auto entity = registry()->GetThirdParty("https://example.com/");
+  ASSERT_TRUE(entity.has_value());
+  EXPECT_EQ(entity.value(), "Example");
+  EXPECT_FALSE(
+      registry()->GetThirdParty("https://google-analytics.com/ga.js"));
+}
+
 }  // namespace brave_perf_predictor
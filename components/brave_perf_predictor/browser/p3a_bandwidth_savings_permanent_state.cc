@@ -47,7 +47,14 @@ void P3ABandwidthSavingsPermanentState::AddSavings(uint64_t delta) {
     daily_savings_.front().saving += delta;
   }
 
+  has_unsaved_savings_ = true;
+}
+
+void P3ABandwidthSavingsPermanentState::Flush() {
+  if (!has_unsaved_savings_)
+    return;
   SaveSavingsDaily();
+  has_unsaved_savings_ = false;
 }
 
 base::Optional<uint64_t>
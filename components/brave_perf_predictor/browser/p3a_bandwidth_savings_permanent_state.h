@@ -19,6 +19,9 @@ namespace brave_perf_predictor {
 // |PrefService| User Preferences for persistency and returns those for the last
 // full period available when queried via |GetFullPeriodSavingsBytes|.
 //
+// Savings are accumulated in memory, and only written to the preferences when
+// |Flush| is called.
+//
 // Time interval to accumulate data for is defined internally and
 // |GetFullPeriodSavingsBytes| returns 0 if there aren't enough readings to
 // cover a full period.
@@ -33,6 +36,8 @@ class P3ABandwidthSavingsPermanentState {
 
   void AddSavings(uint64_t delta);
   base::Optional<uint64_t> GetFullPeriodSavingsBytes();
+  // Writes the savings added since the last flush to the preferences
+  void Flush();
 
  private:
   struct DailySaving {
@@ -47,6 +52,7 @@ class P3ABandwidthSavingsPermanentState {
 
   std::list<DailySaving> daily_savings_;
   PrefService* user_prefs_ = nullptr;
+  bool has_unsaved_savings_ = false;
 };
 
 }  // namespace brave_perf_predictor
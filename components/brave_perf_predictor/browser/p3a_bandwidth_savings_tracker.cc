@@ -33,26 +33,37 @@ constexpr std::array<uint64_t, 7> kBandwidthSavingsBuckets{
 constexpr char kSavingsDailyUMAHistogramName[] =
     "Brave.Savings.BandwidthSavingsMB";
 
+constexpr base::TimeDelta kFlushInterval = base::TimeDelta::FromMinutes(5);
+
 }  // namespace
 
 P3ABandwidthSavingsTracker::P3ABandwidthSavingsTracker(PrefService* user_prefs)
-    : user_prefs_(user_prefs) {}
+    : permanent_state_(
+          std::make_unique<P3ABandwidthSavingsPermanentState>(user_prefs)) {
+  flush_timer_.Start(FROM_HERE, kFlushInterval, this,
+                     &P3ABandwidthSavingsTracker::Flush);
+}
+
+P3ABandwidthSavingsTracker::~P3ABandwidthSavingsTracker() = default;
 
 void P3ABandwidthSavingsTracker::RecordSavings(uint64_t savings) {
-  if (savings > 0 && user_prefs_) {
-    // TODO(AndriusA): optimise if needed, loading permanent state on every
-    // record could be costly
-    auto permanent_state =
-        std::make_unique<P3ABandwidthSavingsPermanentState>(user_prefs_);
-    permanent_state->AddSavings(savings);
-    const auto total = permanent_state->GetFullPeriodSavingsBytes();
+  if (savings > 0) {
+    permanent_state_->AddSavings(savings);
+    const auto total = permanent_state_->GetFullPeriodSavingsBytes();
     if (total.has_value()) {
       StoreSavingsHistogram(total.value());
     }
   }
 }
 
-P3ABandwidthSavingsTracker::~P3ABandwidthSavingsTracker() = default;
+void P3ABandwidthSavingsTracker::Shutdown() {
+  flush_timer_.Stop();
+  Flush();
+}
+
+void P3ABandwidthSavingsTracker::Flush() {
+  permanent_state_->Flush();
+}
 
 // static
 void P3ABandwidthSavingsTracker::RegisterPrefs(PrefRegistrySimple* registry) {
@@ -7,16 +7,25 @@
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_P3A_BANDWIDTH_SAVINGS_TRACKER_H_
 
 #include <cstdint>
+#include <memory>
+
+#include "base/timer/timer.h"
+#include "components/keyed_service/core/keyed_service.h"
 
 class PrefRegistrySimple;
 class PrefService;
 
 namespace brave_perf_predictor {
 
-class P3ABandwidthSavingsTracker {
+class P3ABandwidthSavingsPermanentState;
+
+// Per-profile tracker of the bandwidth savings reported to P3A. Savings of
+// all the tabs are accumulated in memory, and written to the preferences
+// periodically and on shutdown.
+class P3ABandwidthSavingsTracker : public KeyedService {
  public:
   explicit P3ABandwidthSavingsTracker(PrefService* user_prefs);
-  ~P3ABandwidthSavingsTracker();
+  ~P3ABandwidthSavingsTracker() override;
   P3ABandwidthSavingsTracker(const P3ABandwidthSavingsTracker&) = delete;
   P3ABandwidthSavingsTracker& operator=(const P3ABandwidthSavingsTracker&) =
       delete;
@@ -24,9 +33,15 @@ class P3ABandwidthSavingsTracker {
   static void RegisterPrefs(PrefRegistrySimple* registry);
   void RecordSavings(uint64_t savings);
 
+  // KeyedService:
+  void Shutdown() override;
+
  private:
-  PrefService* user_prefs_;
   void StoreSavingsHistogram(uint64_t savings_bytes);
+  void Flush();
+
+  std::unique_ptr<P3ABandwidthSavingsPermanentState> permanent_state_;
+  base::RepeatingTimer flush_timer_;
 };
 
 }  // namespace brave_perf_predictor
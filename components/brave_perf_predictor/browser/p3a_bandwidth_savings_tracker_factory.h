@@ -0,0 +1,45 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_P3A_BANDWIDTH_SAVINGS_TRACKER_FACTORY_H_
+#define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_P3A_BANDWIDTH_SAVINGS_TRACKER_FACTORY_H_
+
+#include "base/memory/singleton.h"
+#include "components/keyed_service/content/browser_context_keyed_service_factory.h"
+
+namespace brave_perf_predictor {
+
+class P3ABandwidthSavingsTracker;
+
+class P3ABandwidthSavingsTrackerFactory
+    : public BrowserContextKeyedServiceFactory {
+ public:
+  // Returns nullptr for off the record contexts
+  static P3ABandwidthSavingsTracker* GetForBrowserContext(
+      content::BrowserContext* context);
+
+  static P3ABandwidthSavingsTrackerFactory* GetInstance();
+
+  P3ABandwidthSavingsTrackerFactory(const P3ABandwidthSavingsTrackerFactory&) =
+      delete;
+  P3ABandwidthSavingsTrackerFactory& operator=(
+      const P3ABandwidthSavingsTrackerFactory&) = delete;
+
+ private:
+  friend struct base::DefaultSingletonTraits<P3ABandwidthSavingsTrackerFactory>;
+
+  P3ABandwidthSavingsTrackerFactory();
+  ~P3ABandwidthSavingsTrackerFactory() override;
+
+  // BrowserContextKeyedServiceFactory:
+  KeyedService* BuildServiceInstanceFor(
+      content::BrowserContext* context) const override;
+  content::BrowserContext* GetBrowserContextToUse(
+      content::BrowserContext* context) const override;
+};
+
+}  // namespace brave_perf_predictor
+
+#endif  // BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_P3A_BANDWIDTH_SAVINGS_TRACKER_FACTORY_H_
@@ -0,0 +1,77 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_perf_predictor/browser/p3a_bandwidth_savings_tracker.h"
+
+#include <cstdint>
+
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "brave/components/brave_perf_predictor/common/pref_names.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_perf_predictor {
+
+class P3ABandwidthSavingsTrackerTest : public ::testing::Test {
+ protected:
+  P3ABandwidthSavingsTrackerTest() {
+    P3ABandwidthSavingsTracker::RegisterPrefs(prefs_.registry());
+  }
+
+  // Savings written to the preferences, over all days.
+  uint64_t SavedBytes() const {
+    uint64_t total = 0;
+    for (const auto& day :
+         prefs_.GetList(prefs::kBandwidthSavedDailyBytes)->GetList()) {
+      base::Optional<double> saving = day.FindDoubleKey("saving");
+      if (saving)
+        total += static_cast<uint64_t>(*saving);
+    }
+    return total;
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  TestingPrefServiceSimple prefs_;
+};
+
+TEST_F(P3ABandwidthSavingsTrackerTest, FlushesPeriodically) {
+  P3ABandwidthSavingsTracker tracker(&prefs_);
+  tracker.RecordSavings(1000);
+  tracker.RecordSavings(2000);
+  EXPECT_EQ(0u, SavedBytes());
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(5));
+  EXPECT_EQ(3000u, SavedBytes());
+
+  tracker.RecordSavings(500);
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(5));
+  EXPECT_EQ(3500u, SavedBytes());
+}
+
+TEST_F(P3ABandwidthSavingsTrackerTest, FlushesOnShutdown) {
+  P3ABandwidthSavingsTracker tracker(&prefs_);
+  tracker.RecordSavings(1000);
+  EXPECT_EQ(0u, SavedBytes());
+
+  tracker.Shutdown();
+  EXPECT_EQ(1000u, SavedBytes());
+
+  // Nothing is flushed once shut down.
+  tracker.RecordSavings(1000);
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(5));
+  EXPECT_EQ(1000u, SavedBytes());
+}
+
+TEST_F(P3ABandwidthSavingsTrackerTest, IgnoresZeroSavings) {
+  P3ABandwidthSavingsTracker tracker(&prefs_);
+  tracker.RecordSavings(0);
+  tracker.Shutdown();
+  EXPECT_TRUE(prefs_.GetList(prefs::kBandwidthSavedDailyBytes)->empty());
+}
+
+}  // namespace brave_perf_predictor
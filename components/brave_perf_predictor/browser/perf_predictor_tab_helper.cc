@@ -5,6 +5,8 @@
 
 #include "brave/components/brave_perf_predictor/browser/perf_predictor_tab_helper.h"
 
+#include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
+#include "brave/components/brave_perf_predictor/browser/p3a_bandwidth_savings_tracker_factory.h"
 #include "brave/components/brave_perf_predictor/common/pref_names.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
@@ -17,34 +19,18 @@
 
 namespace brave_perf_predictor {
 
-namespace {
-content::WebContents* GetWebContents(int render_process_id,
-                                     int render_frame_id,
-                                     int frame_tree_node_id) {
-  content::WebContents* web_contents =
-      content::WebContents::FromFrameTreeNodeId(frame_tree_node_id);
-  if (!web_contents) {
-    content::RenderFrameHost* rfh =
-        content::RenderFrameHost::FromID(render_process_id, render_frame_id);
-    if (!rfh) {
-      return nullptr;
-    }
-    web_contents = content::WebContents::FromRenderFrameHost(rfh);
-  }
-  return web_contents;
-}
-
-}  // namespace
-
 PerfPredictorTabHelper::PerfPredictorTabHelper(
     content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       bandwidth_predictor_(std::make_unique<BandwidthSavingsPredictor>()) {
+  // Load the third parties before the first page load needs them
+  NamedThirdPartyRegistry::GetInstance()->InitializeDefault();
+
   if (web_contents->GetBrowserContext()->IsOffTheRecord())
     return;
 
-  bandwidth_tracker_ = std::make_unique<P3ABandwidthSavingsTracker>(
-      user_prefs::UserPrefs::Get(web_contents->GetBrowserContext()));
+  bandwidth_tracker_ = P3ABandwidthSavingsTrackerFactory::GetForBrowserContext(
+      web_contents->GetBrowserContext());
 }
 
 PerfPredictorTabHelper::~PerfPredictorTabHelper() = default;
@@ -60,27 +46,6 @@ void PerfPredictorTabHelper::RegisterProfilePrefs(
   registry->RegisterUint64Pref(prefs::kBandwidthSavedBytes, 0);
 }
 
-// static
-void PerfPredictorTabHelper::DispatchBlockedEvent(
-    const std::string& subresource,
-    int render_process_id,
-    int render_frame_id,
-    int frame_tree_node_id) {
-  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-
-  content::WebContents* web_contents =
-      GetWebContents(render_process_id, render_frame_id, frame_tree_node_id);
-  if (!web_contents)
-    return;
-
-  PerfPredictorTabHelper* blocking_observer =
-      brave_perf_predictor::PerfPredictorTabHelper::FromWebContents(
-          web_contents);
-  if (blocking_observer) {
-    blocking_observer->OnBlockedSubresource(subresource);
-  }
-}
-
 void PerfPredictorTabHelper::RecordSavings() {
   if (web_contents()) {
     const uint64_t savings =
@@ -105,9 +70,10 @@ void PerfPredictorTabHelper::RecordSavings() {
   }
 }
 
-void PerfPredictorTabHelper::OnBlockedSubresource(
-    const std::string& subresource) {
-  bandwidth_predictor_->OnSubresourceBlocked(subresource);
+void PerfPredictorTabHelper::OnBlockedSubresources(
+    const std::vector<std::string>& subresources) {
+  for (const std::string& subresource : subresources)
+    bandwidth_predictor_->OnSubresourceBlocked(subresource);
 }
 
 void PerfPredictorTabHelper::DidStartNavigation(
@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "brave/components/brave_perf_predictor/browser/bandwidth_savings_predictor.h"
 #include "brave/components/brave_perf_predictor/browser/p3a_bandwidth_savings_tracker.h"
@@ -52,16 +53,13 @@ class PerfPredictorTabHelper
   void OnPageLoadTimingUpdated(
       const page_load_metrics::mojom::PageLoadTiming& timing);
   static void RegisterProfilePrefs(PrefRegistrySimple* registry);
-  // Called from Brave Shields
-  static void DispatchBlockedEvent(const std::string& subresource,
-                                   int render_process_id,
-                                   int render_frame_id,
-                                   int frame_tree_node_id);
+  // Called from Brave Shields with the subresources blocked since its last
+  // batch of blocked events.
+  void OnBlockedSubresources(const std::vector<std::string>& subresources);
 
  private:
   friend class content::WebContentsUserData<PerfPredictorTabHelper>;
   void RecordSavings();
-  void OnBlockedSubresource(const std::string& subresource);
 
   // content::WebContentsObserver overrides.
 
@@ -93,7 +91,8 @@ class PerfPredictorTabHelper
 
   int64_t navigation_id_ = -1;
   std::unique_ptr<BandwidthSavingsPredictor> bandwidth_predictor_;
-  std::unique_ptr<P3ABandwidthSavingsTracker> bandwidth_tracker_;
+  // Owned by the browser context, null when off the record
+  P3ABandwidthSavingsTracker* bandwidth_tracker_ = nullptr;
 
   WEB_CONTENTS_USER_DATA_KEY_DECL();
 };
@@ -3,6 +3,8 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <memory>
+
 #include "base/path_service.h"
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
@@ -13,6 +15,7 @@
 #include "brave/components/brave_perf_predictor/common/pref_names.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/ui/browser.h"
 #include "chrome/test/base/in_process_browser_test.h"
@@ -40,6 +43,15 @@ class PerfPredictorTabHelperTest : public InProcessBrowserTest {
   void SetUpOnMainThread() override {
     InProcessBrowserTest::SetUpOnMainThread();
     host_resolver()->AddRule("*", "127.0.0.1");
+    // Pref counters are checked right after each blocked request.
+    flush_blocked_events_immediately_ = std::make_unique<
+        brave_shields::BraveShieldsWebContentsObserver::
+            ScopedFlushBlockedEventsImmediatelyForTesting>();
+  }
+
+  void TearDownOnMainThread() override {
+    flush_blocked_events_immediately_.reset();
+    InProcessBrowserTest::TearDownOnMainThread();
   }
 
   void SetUp() override {
@@ -74,6 +86,11 @@ class PerfPredictorTabHelperTest : public InProcessBrowserTest {
             .get()));
     ASSERT_TRUE(io_helper->Run());
   }
+
+ private:
+  std::unique_ptr<brave_shields::BraveShieldsWebContentsObserver::
+                      ScopedFlushBlockedEventsImmediatelyForTesting>
+      flush_blocked_events_immediately_;
 };
 
 IN_PROC_BROWSER_TEST_F(PerfPredictorTabHelperTest, NoBlockNoSavings) {
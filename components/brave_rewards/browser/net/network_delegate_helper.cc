@@ -77,8 +77,9 @@ int OnBeforeURLRequest(
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
   if (IsMediaLink(ctx->request_url, ctx->tab_origin, ctx->referrer)) {
-    if (!ctx->upload_data.empty()) {
-      DispatchOnUI(ctx->upload_data,
+    const std::string& upload_data = ctx->GetUploadData();
+    if (!upload_data.empty()) {
+      DispatchOnUI(upload_data,
                    ctx->request_url,
                    ctx->tab_url,
                    ctx->referrer.spec(),
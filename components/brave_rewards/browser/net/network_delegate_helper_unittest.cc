@@ -0,0 +1,104 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/net/network_delegate_helper.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "brave/browser/net/url_context.h"
+#include "chrome/test/base/testing_profile.h"
+#include "content/public/test/browser_task_environment.h"
+#include "net/base/net_errors.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/resource_request_body.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+const char kMediaUrl[] =
+    "https://fresnel.vimeocdn.com/add/player-stats?beacon=1";
+const char kOtherUrl[] = "https://example.com/form";
+
+}  // namespace
+
+class RewardsNetworkDelegateHelperTest : public testing::Test {
+ public:
+  RewardsNetworkDelegateHelperTest() = default;
+  ~RewardsNetworkDelegateHelperTest() override = default;
+
+  void SetUp() override { profile_ = std::make_unique<TestingProfile>(); }
+
+  TestingProfile* profile() { return profile_.get(); }
+
+  // Returns the context of a POST request to |url|, with a body made of
+  // "a=1", a file and "&b=2".
+  std::shared_ptr<brave::BraveRequestInfo> CreateContext(const GURL& url) {
+    network::ResourceRequest request;
+    request.url = url;
+    request.method = "POST";
+    request_body_ = new network::ResourceRequestBody;
+    request_body_->AppendBytes("a=1", 3);
+    request_body_->AppendFileRange(
+        base::FilePath(FILE_PATH_LITERAL("upload.bin")), 0, 8, base::Time());
+    request_body_->AppendBytes("&b=2", 4);
+    request.request_body = request_body_;
+
+    auto ctx = std::make_shared<brave::BraveRequestInfo>();
+    brave::BraveRequestInfo::FillCTX(request, 0, 0, 0, profile(), ctx);
+    return ctx;
+  }
+
+  // Adds bytes to the body of the last request after its context was filled,
+  // which only shows in the upload data if it was not copied yet.
+  void AppendToRequestBody() { request_body_->AppendBytes("&c=3", 4); }
+
+ private:
+  content::BrowserTaskEnvironment task_environment_;
+  std::unique_ptr<TestingProfile> profile_;
+  scoped_refptr<network::ResourceRequestBody> request_body_;
+
+  DISALLOW_COPY_AND_ASSIGN(RewardsNetworkDelegateHelperTest);
+};
+
+TEST_F(RewardsNetworkDelegateHelperTest, CopiesUploadDataOfMediaLinks) {
+  std::shared_ptr<brave::BraveRequestInfo> ctx =
+      CreateContext(GURL(kMediaUrl));
+  brave::ResponseCallback callback;
+  EXPECT_EQ(net::OK, brave_rewards::OnBeforeURLRequest(callback, ctx));
+
+  // The helper copied the bytes elements of the body.
+  AppendToRequestBody();
+  EXPECT_EQ("a=1&b=2", ctx->GetUploadData());
+}
+
+TEST_F(RewardsNetworkDelegateHelperTest, SkipsUploadDataOfOtherRequests) {
+  std::shared_ptr<brave::BraveRequestInfo> ctx =
+      CreateContext(GURL(kOtherUrl));
+  brave::ResponseCallback callback;
+  EXPECT_EQ(net::OK, brave_rewards::OnBeforeURLRequest(callback, ctx));
+
+  // Neither filling the context nor the helper copied the body.
+  AppendToRequestBody();
+  EXPECT_EQ("a=1&b=2&c=3", ctx->GetUploadData());
+
+  // The body is only copied once.
+  AppendToRequestBody();
+  EXPECT_EQ("a=1&b=2&c=3", ctx->GetUploadData());
+}
+
+TEST_F(RewardsNetworkDelegateHelperTest, EmptyUploadDataWithoutBody) {
+  network::ResourceRequest request;
+  request.url = GURL(kMediaUrl);
+  auto ctx = std::make_shared<brave::BraveRequestInfo>();
+  brave::BraveRequestInfo::FillCTX(request, 0, 0, 0, profile(), ctx);
+  brave::ResponseCallback callback;
+  EXPECT_EQ(net::OK, brave_rewards::OnBeforeURLRequest(callback, ctx));
+  EXPECT_TRUE(ctx->GetUploadData().empty());
+}
@@ -11,7 +11,9 @@
 #include <vector>
 
 #include "base/bind.h"
+#include "base/bind_helpers.h"
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/json/json_reader.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
@@ -100,13 +102,56 @@ std::string ResourceTypeToString(content::ResourceType resource_type) {
   return filter_option;
 }
 
+// The engine is deserialized straight from a read-only mapping of the DAT
+// file instead of a heap copy of it. adblock-rust copies what it needs out of
+// the DAT data, so the mapping is released as soon as the engine is built,
+// still on the blocking sequence.
+std::unique_ptr<adblock::Engine> LoadAdBlockEngine(
+    const base::FilePath& dat_file_path) {
+  std::unique_ptr<base::MemoryMappedFile> mapping =
+      brave_component_updater::MapDATFile(dat_file_path);
+  if (!mapping)
+    return nullptr;
+  auto engine = std::make_unique<adblock::Engine>();
+  if (!engine->deserialize(reinterpret_cast<const char*>(mapping->data()),
+                           mapping->length()))
+    return nullptr;
+  return engine;
+}
+
 }  // namespace
 
 namespace brave_shields {
 
+AdBlockRequest::AdBlockRequest(const GURL& url,
+                               content::ResourceType resource_type,
+                               const std::string& tab_host)
+    : url_spec(url.spec()),
+      url_host(url.host()),
+      tab_host(tab_host),
+      resource_type(ResourceTypeToString(resource_type)),
+      // Determine third-party here so the library doesn't need to figure it
+      // out. CreateFromNormalizedTuple is needed because SameDomainOrHost
+      // needs a URL or origin and not a string to a host name.
+      is_third_party(!SameDomainOrHost(
+          url,
+          url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
+          INCLUDE_PRIVATE_REGISTRIES)) {}
+
+AdBlockRequest::~AdBlockRequest() {}
+
+AdBlockEngineSnapshot::AdBlockEngineSnapshot(
+    std::unique_ptr<adblock::Engine> engine)
+    : engine_(std::move(engine)) {}
+
+AdBlockEngineSnapshot::~AdBlockEngineSnapshot() {}
+
 AdBlockBaseService::AdBlockBaseService(BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
-      ad_block_client_(new adblock::Engine()),
+      engine_(base::MakeRefCounted<AdBlockEngineSnapshot>(
+          std::make_unique<adblock::Engine>())),
+      has_engine_source_(false),
+      rebuild_pending_(false),
       weak_factory_(this) {}
 
 AdBlockBaseService::~AdBlockBaseService() {
@@ -114,7 +159,22 @@ AdBlockBaseService::~AdBlockBaseService() {
 }
 
 void AdBlockBaseService::Cleanup() {
-  GetTaskRunner()->DeleteSoon(FROM_HERE, ad_block_client_.release());
+  scoped_refptr<AdBlockEngineSnapshot> engine;
+  {
+    base::AutoLock lock(engine_lock_);
+    engine = std::move(engine_);
+  }
+  // Let the engine go on the task runner, unless a reader still holds it.
+  GetTaskRunner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(
+          base::DoNothing::Once<scoped_refptr<AdBlockEngineSnapshot>>(),
+          std::move(engine)));
+}
+
+scoped_refptr<AdBlockEngineSnapshot> AdBlockBaseService::GetEngineSnapshot() {
+  base::AutoLock lock(engine_lock_);
+  return engine_;
 }
 
 bool AdBlockBaseService::ShouldStartRequest(const GURL& url,
@@ -123,20 +183,24 @@ bool AdBlockBaseService::ShouldStartRequest(const GURL& url,
                                             bool* did_match_exception,
                                             bool* cancel_request_explicitly,
                                             std::string* mock_data_url) {
-  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  return ShouldStartRequest(AdBlockRequest(url, resource_type, tab_host),
+                            did_match_exception, cancel_request_explicitly,
+                            mock_data_url);
+}
+
+bool AdBlockBaseService::ShouldStartRequest(const AdBlockRequest& request,
+                                            bool* did_match_exception,
+                                            bool* cancel_request_explicitly,
+                                            std::string* mock_data_url) {
+  scoped_refptr<AdBlockEngineSnapshot> engine = GetEngineSnapshot();
+  if (!engine)
+    return true;
 
-  // Determine third-party here so the library doesn't need to figure it out.
-  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
-  // a URL or origin and not a string to a host name.
-  bool is_third_party = !SameDomainOrHost(
-      url,
-      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
-      INCLUDE_PRIVATE_REGISTRIES);
   bool explicit_cancel;
   bool saved_from_exception;
-  if (ad_block_client_->matches(
-          url.spec(), url.host(), tab_host, is_third_party,
-          ResourceTypeToString(resource_type), &explicit_cancel,
+  if (engine->engine()->matches(
+          request.url_spec, request.url_host, request.tab_host,
+          request.is_third_party, request.resource_type, &explicit_cancel,
           &saved_from_exception, mock_data_url)) {
     if (cancel_request_explicitly) {
       *cancel_request_explicitly = explicit_cancel;
@@ -146,9 +210,9 @@ bool AdBlockBaseService::ShouldStartRequest(const GURL& url,
       *did_match_exception = false;
     }
     // LOG(ERROR) << "AdBlockBaseService::ShouldStartRequest(), host: "
-    //  << tab_host
-    //  << ", resource type: " << resource_type
-    //  << ", url.spec(): " << url.spec();
+    //  << request.tab_host
+    //  << ", resource type: " << request.resource_type
+    //  << ", url.spec(): " << request.url_spec;
     return false;
   }
 
@@ -167,17 +231,16 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
     return;
   }
 
+  std::vector<std::string>::iterator it =
+      std::find(tags_.begin(), tags_.end(), tag);
+  if (enabled == (it != tags_.end()))
+    return;
   if (enabled) {
-    ad_block_client_->addTag(tag);
     tags_.push_back(tag);
   } else {
-    ad_block_client_->removeTag(tag);
-    std::vector<std::string>::iterator it =
-        std::find(tags_.begin(), tags_.end(), tag);
-    if (it != tags_.end()) {
-      tags_.erase(it);
-    }
+    tags_.erase(it);
   }
+  ScheduleRebuildAdBlockClient();
 }
 
 void AdBlockBaseService::AddResources(const std::string& resources) {
@@ -188,8 +251,8 @@ void AdBlockBaseService::AddResources(const std::string& resources) {
     return;
   }
 
-  ad_block_client_->addResources(resources);
   resources_ = resources;
+  ScheduleRebuildAdBlockClient();
 }
 
 bool AdBlockBaseService::TagExists(const std::string& tag) {
@@ -198,58 +261,124 @@ bool AdBlockBaseService::TagExists(const std::string& tag) {
 
 base::Optional<base::Value> AdBlockBaseService::HostnameCosmeticResources(
         const std::string& hostname) {
+  scoped_refptr<AdBlockEngineSnapshot> engine = GetEngineSnapshot();
+  if (!engine)
+    return base::nullopt;
   return base::JSONReader::Read(
-          this->ad_block_client_->hostnameCosmeticResources(hostname));
+          engine->engine()->hostnameCosmeticResources(hostname));
 }
 
 std::string AdBlockBaseService::HiddenClassIdSelectors(
         const std::vector<std::string>& classes,
         const std::vector<std::string>& ids,
         const std::vector<std::string>& exceptions) {
-  return this->ad_block_client_->hiddenClassIdSelectors(classes,
-                                                        ids,
-                                                        exceptions);
+  scoped_refptr<AdBlockEngineSnapshot> engine = GetEngineSnapshot();
+  if (!engine)
+    return std::string();
+  return engine->engine()->hiddenClassIdSelectors(classes,
+                                                  ids,
+                                                  exceptions);
 }
 
 void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
   base::PostTaskAndReplyWithResult(
       FROM_HERE, {base::ThreadPool(), base::MayBlock()},
-      base::BindOnce(&brave_component_updater::LoadDATFileData<adblock::Engine>,
-                     dat_file_path),
+      base::BindOnce(&LoadAdBlockEngine, dat_file_path),
       base::BindOnce(&AdBlockBaseService::OnGetDATFileData,
-                     weak_factory_.GetWeakPtr()));
+                     weak_factory_.GetWeakPtr(), dat_file_path));
 }
 
-void AdBlockBaseService::OnGetDATFileData(GetDATFileDataResult result) {
-  if (result.second.empty()) {
-    LOG(ERROR) << "Could not obtain ad block data";
-    return;
-  }
-  if (!result.first.get()) {
-    LOG(ERROR) << "Failed to deserialize ad block data";
+void AdBlockBaseService::OnGetDATFileData(
+    const base::FilePath& dat_file_path,
+    std::unique_ptr<adblock::Engine> ad_block_client) {
+  if (!ad_block_client) {
+    LOG(ERROR) << "Failed to load ad block data";
     return;
   }
   GetTaskRunner()->PostTask(
       FROM_HERE, base::BindOnce(&AdBlockBaseService::UpdateAdBlockClient,
-                                base::Unretained(this),
-                                std::move(result.first)));
+                                base::Unretained(this), dat_file_path,
+                                std::move(ad_block_client)));
 }
 
 void AdBlockBaseService::UpdateAdBlockClient(
+    const base::FilePath& dat_file_path,
     std::unique_ptr<adblock::Engine> ad_block_client) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  ad_block_client_ = std::move(ad_block_client);
-  AddKnownTagsToAdBlockInstance();
-  AddKnownResourcesToAdBlockInstance();
+  dat_file_path_ = dat_file_path;
+  rules_.clear();
+  has_engine_source_ = true;
+  AddKnownTagsAndResources(ad_block_client.get());
+  PublishAdBlockClient(std::move(ad_block_client));
+}
+
+void AdBlockBaseService::UpdateAdBlockClientFromRules(
+    const std::string& rules) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  dat_file_path_.clear();
+  rules_ = rules;
+  has_engine_source_ = true;
+  std::unique_ptr<adblock::Engine> ad_block_client = CreateAdBlockClient();
+  AddKnownTagsAndResources(ad_block_client.get());
+  PublishAdBlockClient(std::move(ad_block_client));
 }
 
-void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
+std::unique_ptr<adblock::Engine> AdBlockBaseService::CreateAdBlockClient() {
+  if (dat_file_path_.empty())
+    return std::make_unique<adblock::Engine>(rules_);
+  // Published engines are shared with readers on other threads and are never
+  // modified, so a new one is deserialized from the DAT file the current one
+  // was loaded from.
+  return LoadAdBlockEngine(dat_file_path_);
+}
+
+void AdBlockBaseService::AddKnownTagsAndResources(
+    adblock::Engine* ad_block_client) {
   std::for_each(tags_.begin(), tags_.end(),
-                [&](const std::string tag) { ad_block_client_->addTag(tag); });
+                [&](const std::string tag) { ad_block_client->addTag(tag); });
+  ad_block_client->addResources(resources_);
 }
 
-void AdBlockBaseService::AddKnownResourcesToAdBlockInstance() {
-  ad_block_client_->addResources(resources_);
+void AdBlockBaseService::ScheduleRebuildAdBlockClient() {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  // Until the engine is loaded there is nothing to rebuild; the loaded
+  // engine picks up the current tags and resources.
+  if (!has_engine_source_)
+    return;
+  // Tag and resource updates tend to arrive together, so they share a
+  // single rebuild.
+  if (rebuild_pending_)
+    return;
+  rebuild_pending_ = true;
+  GetTaskRunner()->PostTask(
+      FROM_HERE, base::BindOnce(&AdBlockBaseService::RebuildAdBlockClient,
+                                weak_factory_.GetWeakPtr()));
+}
+
+void AdBlockBaseService::RebuildAdBlockClient() {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  rebuild_pending_ = false;
+  std::unique_ptr<adblock::Engine> ad_block_client = CreateAdBlockClient();
+  if (!ad_block_client) {
+    // The DAT file may be gone after a component update. |tags_| and
+    // |resources_| keep the change, so it is applied to the engine built by
+    // the next DAT load.
+    LOG(ERROR) << "Failed to rebuild ad block engine, keeping the current "
+                  "one until the next update";
+    return;
+  }
+  AddKnownTagsAndResources(ad_block_client.get());
+  PublishAdBlockClient(std::move(ad_block_client));
+}
+
+void AdBlockBaseService::PublishAdBlockClient(
+    std::unique_ptr<adblock::Engine> ad_block_client) {
+  scoped_refptr<AdBlockEngineSnapshot> engine =
+      base::MakeRefCounted<AdBlockEngineSnapshot>(std::move(ad_block_client));
+  // The old snapshot is released outside the lock; readers that still hold
+  // it finish their lookups first.
+  base::AutoLock lock(engine_lock_);
+  engine_.swap(engine);
 }
 
 bool AdBlockBaseService::Init() {
@@ -261,12 +390,15 @@ void AdBlockBaseService::ResetForTest(const std::string& rules,
   // This is temporary until adblock-rust supports incrementally adding
   // filter rules to an existing instance. At which point the hack below
   // will dissapear.
-  ad_block_client_.reset(new adblock::Engine(rules));
-  AddKnownTagsToAdBlockInstance();
+  dat_file_path_.clear();
+  rules_ = rules;
+  has_engine_source_ = true;
   if (!resources.empty()) {
     resources_ = resources;
   }
-  AddKnownResourcesToAdBlockInstance();
+  std::unique_ptr<adblock::Engine> ad_block_client = CreateAdBlockClient();
+  AddKnownTagsAndResources(ad_block_client.get());
+  PublishAdBlockClient(std::move(ad_block_client));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -14,8 +14,10 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
+#include "base/synchronization/lock.h"
 #include "base/values.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
@@ -30,19 +32,55 @@ class Engine;
 
 namespace brave_shields {
 
+// The parts of a request that every ad-block engine needs. Computing them
+// once lets a request be matched against several engines without redoing
+// the string and registry work for each one.
+struct AdBlockRequest {
+  AdBlockRequest(const GURL& url,
+                 content::ResourceType resource_type,
+                 const std::string& tab_host);
+  ~AdBlockRequest();
+
+  std::string url_spec;
+  std::string url_host;
+  std::string tab_host;
+  std::string resource_type;
+  bool is_third_party;
+};
+
+// An ad-block engine that is never modified once published. Readers on any
+// thread hold a reference for the duration of a lookup; tag and resource
+// changes build a new snapshot that replaces the current one.
+class AdBlockEngineSnapshot
+    : public base::RefCountedThreadSafe<AdBlockEngineSnapshot> {
+ public:
+  explicit AdBlockEngineSnapshot(std::unique_ptr<adblock::Engine> engine);
+
+  adblock::Engine* engine() const { return engine_.get(); }
+
+ private:
+  friend class base::RefCountedThreadSafe<AdBlockEngineSnapshot>;
+  ~AdBlockEngineSnapshot();
+
+  std::unique_ptr<adblock::Engine> engine_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockEngineSnapshot);
+};
+
 // The base class of the brave shields service in charge of ad-block
 // checking and init.
 class AdBlockBaseService : public BaseBraveShieldsService {
  public:
-  using GetDATFileDataResult =
-      brave_component_updater::LoadDATFileDataResult<adblock::Engine>;
-
   explicit AdBlockBaseService(BraveComponent::Delegate* delegate);
   ~AdBlockBaseService() override;
 
   bool ShouldStartRequest(const GURL &url, content::ResourceType resource_type,
     const std::string& tab_host, bool* did_match_exception,
     bool* cancel_request_explicitly, std::string* mock_data_url) override;
+  bool ShouldStartRequest(const AdBlockRequest& request,
+                          bool* did_match_exception,
+                          bool* cancel_request_explicitly,
+                          std::string* mock_data_url);
   void AddResources(const std::string& resources);
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
@@ -60,17 +98,38 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   void Cleanup() override;
 
   void GetDATFileData(const base::FilePath& dat_file_path);
-  void AddKnownTagsToAdBlockInstance();
-  void AddKnownResourcesToAdBlockInstance();
+  // Replaces the engine with one built from |rules|, keeping known tags and
+  // resources. Must be called on the task runner.
+  void UpdateAdBlockClientFromRules(const std::string& rules);
   void ResetForTest(const std::string& rules, const std::string& resources);
 
-  std::unique_ptr<adblock::Engine> ad_block_client_;
+  // Returns the current engine snapshot. Safe to call from any thread.
+  scoped_refptr<AdBlockEngineSnapshot> GetEngineSnapshot();
 
  private:
-  void UpdateAdBlockClient(
-      std::unique_ptr<adblock::Engine> ad_block_client);
-  void OnGetDATFileData(GetDATFileDataResult result);
+  void UpdateAdBlockClient(const base::FilePath& dat_file_path,
+                           std::unique_ptr<adblock::Engine> ad_block_client);
+  void OnGetDATFileData(const base::FilePath& dat_file_path,
+                        std::unique_ptr<adblock::Engine> ad_block_client);
   void OnPreferenceChanges(const std::string& pref_name);
+  std::unique_ptr<adblock::Engine> CreateAdBlockClient();
+  void AddKnownTagsAndResources(adblock::Engine* ad_block_client);
+  void ScheduleRebuildAdBlockClient();
+  void RebuildAdBlockClient();
+  void PublishAdBlockClient(std::unique_ptr<adblock::Engine> ad_block_client);
+
+  // Only the pointer swap and copy are guarded; lookups run on the snapshot
+  // without holding |engine_lock_|.
+  base::Lock engine_lock_;
+  scoped_refptr<AdBlockEngineSnapshot> engine_;
+
+  // Where the current engine came from, so it can be rebuilt when tags or
+  // resources change. The DAT data itself is not kept once the engine is
+  // built. Accessed on the task runner only.
+  base::FilePath dat_file_path_;
+  std::string rules_;
+  bool has_engine_source_;
+  bool rebuild_pending_;
 
   std::vector<std::string> tags_;
   std::string resources_;
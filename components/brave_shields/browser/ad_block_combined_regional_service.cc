@@ -0,0 +1,103 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_combined_regional_service.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/ad_block_service_helper.h"
+#include "content/public/browser/browser_thread.h"
+
+using content::BrowserThread;
+
+namespace brave_shields {
+
+AdBlockCombinedRegionalService::AdBlockCombinedRegionalService(
+    brave_component_updater::BraveComponent::Delegate* delegate)
+    : AdBlockBaseService(delegate),
+      rebuild_pending_(false) {
+}
+
+AdBlockCombinedRegionalService::~AdBlockCombinedRegionalService() {
+}
+
+bool AdBlockCombinedRegionalService::Init() {
+  return AdBlockBaseService::Init();
+}
+
+void AdBlockCombinedRegionalService::SetFilterListRulesFile(
+    const std::string& uuid,
+    const base::FilePath& rules_file_path) {
+  if (BrowserThread::CurrentlyOn(BrowserThread::UI)) {
+    GetTaskRunner()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&AdBlockCombinedRegionalService::SetFilterListRulesFile,
+                       base::Unretained(this), uuid, rules_file_path));
+    return;
+  }
+
+  if (rules_file_path.empty()) {
+    filter_list_files_.erase(uuid);
+  } else {
+    filter_list_files_[uuid] = rules_file_path;
+  }
+
+  // Lists are usually toggled or updated a few at a time, so they share a
+  // single rebuild.
+  if (rebuild_pending_)
+    return;
+  rebuild_pending_ = true;
+  GetTaskRunner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&AdBlockCombinedRegionalService::RebuildCombinedEngine,
+                     base::Unretained(this)));
+}
+
+size_t AdBlockCombinedRegionalService::GetUniqueRuleCount(
+    const std::string& uuid) {
+  base::AutoLock lock(unique_rule_counts_lock_);
+  auto it = unique_rule_counts_.find(uuid);
+  return it == unique_rule_counts_.end() ? 0 : it->second;
+}
+
+void AdBlockCombinedRegionalService::RebuildCombinedEngine() {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  rebuild_pending_ = false;
+
+  std::string merged_rules;
+  std::map<std::string, size_t> unique_rule_counts;
+  {
+    std::map<std::string, std::string> filter_lists;
+    for (const auto& filter_list_file : filter_list_files_) {
+      // A file removed by a component update is picked up again once the
+      // new version reports its own path.
+      if (!base::PathExists(filter_list_file.second))
+        continue;
+      filter_lists[filter_list_file.first] =
+          brave_component_updater::GetDATFileAsString(filter_list_file.second);
+    }
+    merged_rules = MergeFilterLists(filter_lists, &unique_rule_counts);
+  }
+  UpdateAdBlockClientFromRules(merged_rules);
+
+  base::AutoLock lock(unique_rule_counts_lock_);
+  unique_rule_counts_.swap(unique_rule_counts);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+std::unique_ptr<AdBlockCombinedRegionalService>
+AdBlockCombinedRegionalServiceFactory(
+    brave_component_updater::BraveComponent::Delegate* delegate) {
+  return std::make_unique<AdBlockCombinedRegionalService>(delegate);
+}
+
+}  // namespace brave_shields
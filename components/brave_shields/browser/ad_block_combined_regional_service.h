@@ -0,0 +1,65 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_COMBINED_REGIONAL_SERVICE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_COMBINED_REGIONAL_SERVICE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/synchronization/lock.h"
+#include "brave/components/brave_shields/browser/ad_block_base_service.h"
+
+class AdBlockServiceTest;
+
+namespace brave_shields {
+
+// The brave shields service holding a single engine built from the
+// deduplicated rules of every enabled regional filter list, in place of one
+// engine per list.
+class AdBlockCombinedRegionalService : public AdBlockBaseService {
+ public:
+  explicit AdBlockCombinedRegionalService(
+      brave_component_updater::BraveComponent::Delegate* delegate);
+  ~AdBlockCombinedRegionalService() override;
+
+  // Sets the plain-text rules file of the list identified by |uuid| and
+  // rebuilds the combined engine in the background. An empty
+  // |rules_file_path| removes the list.
+  void SetFilterListRulesFile(const std::string& uuid,
+                              const base::FilePath& rules_file_path);
+
+  // Returns how many rules of the list identified by |uuid| are found in no
+  // other enabled list.
+  size_t GetUniqueRuleCount(const std::string& uuid);
+
+ protected:
+  bool Init() override;
+
+ private:
+  friend class ::AdBlockServiceTest;
+  void RebuildCombinedEngine();
+
+  // Accessed on the task runner only. The rule text is read from these
+  // files for each rebuild and released once merged.
+  std::map<std::string, base::FilePath> filter_list_files_;
+  bool rebuild_pending_;
+
+  base::Lock unique_rule_counts_lock_;
+  std::map<std::string, size_t> unique_rule_counts_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockCombinedRegionalService);
+};
+
+// Creates the AdBlockCombinedRegionalService
+std::unique_ptr<AdBlockCombinedRegionalService>
+AdBlockCombinedRegionalServiceFactory(
+    brave_component_updater::BraveComponent::Delegate* delegate);
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_COMBINED_REGIONAL_SERVICE_H_
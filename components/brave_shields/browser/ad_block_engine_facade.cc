@@ -0,0 +1,57 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_engine_facade.h"
+
+#include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
+#include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
+#include "brave/components/brave_shields/browser/ad_block_service.h"
+
+namespace brave_shields {
+
+AdBlockEngineFacade::AdBlockEngineFacade(
+    AdBlockService* ad_block_service,
+    AdBlockRegionalServiceManager* regional_service_manager,
+    AdBlockCustomFiltersService* custom_filters_service)
+    : ad_block_service_(ad_block_service),
+      regional_service_manager_(regional_service_manager),
+      custom_filters_service_(custom_filters_service) {}
+
+AdBlockEngineFacade::~AdBlockEngineFacade() {}
+
+bool AdBlockEngineFacade::ShouldStartRequest(
+    const AdBlockRequest& request,
+    bool* cancel_request_explicitly,
+    std::string* mock_data_url) {
+  bool did_match_exception = false;
+  if (ad_block_service_ &&
+      !ad_block_service_->ShouldStartRequest(request, &did_match_exception,
+                                             cancel_request_explicitly,
+                                             mock_data_url)) {
+    return false;
+  }
+  if (did_match_exception)
+    return true;
+
+  if (regional_service_manager_ &&
+      !regional_service_manager_->ShouldStartRequest(
+          request, &did_match_exception, cancel_request_explicitly,
+          mock_data_url)) {
+    return false;
+  }
+  if (did_match_exception)
+    return true;
+
+  if (custom_filters_service_ &&
+      !custom_filters_service_->ShouldStartRequest(
+          request, &did_match_exception, cancel_request_explicitly,
+          mock_data_url)) {
+    return false;
+  }
+
+  return true;
+}
+
+}  // namespace brave_shields
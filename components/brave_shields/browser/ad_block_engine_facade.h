@@ -0,0 +1,46 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_FACADE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_FACADE_H_
+
+#include <string>
+
+#include "base/macros.h"
+
+namespace brave_shields {
+
+class AdBlockCustomFiltersService;
+class AdBlockRegionalServiceManager;
+class AdBlockService;
+struct AdBlockRequest;
+
+// Matches a request against the default, regional and custom filter engines
+// in a single pass. Engines are immutable snapshots, so this can be used
+// from any sequence.
+class AdBlockEngineFacade {
+ public:
+  AdBlockEngineFacade(AdBlockService* ad_block_service,
+                      AdBlockRegionalServiceManager* regional_service_manager,
+                      AdBlockCustomFiltersService* custom_filters_service);
+  ~AdBlockEngineFacade();
+
+  // Returns false if any engine blocks the request. An exception filter
+  // matched by one engine stops the engines after it from being consulted.
+  bool ShouldStartRequest(const AdBlockRequest& request,
+                          bool* cancel_request_explicitly,
+                          std::string* mock_data_url);
+
+ private:
+  AdBlockService* ad_block_service_;  // NOT OWNED
+  AdBlockRegionalServiceManager* regional_service_manager_;  // NOT OWNED
+  AdBlockCustomFiltersService* custom_filters_service_;  // NOT OWNED
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockEngineFacade);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_FACADE_H_
@@ -0,0 +1,67 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_regional_rules_component.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/task_runner_util.h"
+#include "brave/components/brave_shields/browser/ad_block_service_helper.h"
+#include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
+
+namespace brave_shields {
+
+AdBlockRegionalRulesComponent::AdBlockRegionalRulesComponent(
+    const std::string& uuid,
+    brave_component_updater::BraveComponent::Delegate* delegate,
+    RulesFileReadyCallback callback)
+    : BraveComponent(delegate),
+      uuid_(uuid),
+      rules_file_ready_callback_(std::move(callback)),
+      weak_factory_(this) {
+}
+
+AdBlockRegionalRulesComponent::~AdBlockRegionalRulesComponent() {
+}
+
+bool AdBlockRegionalRulesComponent::Init() {
+  std::vector<adblock::FilterList>& region_lists =
+      adblock::FilterList::GetRegionalLists();
+  auto it = brave_shields::FindAdBlockFilterListByUUID(region_lists, uuid_);
+  if (it == region_lists.end())
+    return false;
+
+  Register(it->title, it->component_id, it->base64_public_key);
+  return true;
+}
+
+void AdBlockRegionalRulesComponent::OnComponentReady(
+    const std::string& component_id,
+    const base::FilePath& install_dir,
+    const std::string& manifest) {
+  base::FilePath rules_file_path =
+      install_dir.AppendASCII(std::string("rs-") + uuid_)
+          .AddExtension(FILE_PATH_LITERAL(".txt"));
+  base::PostTaskAndReplyWithResult(
+      GetTaskRunner().get(), FROM_HERE,
+      base::BindOnce(&base::PathExists, rules_file_path),
+      base::BindOnce(&AdBlockRegionalRulesComponent::OnRulesFileChecked,
+                     weak_factory_.GetWeakPtr(), rules_file_path));
+}
+
+void AdBlockRegionalRulesComponent::OnRulesFileChecked(
+    const base::FilePath& rules_file_path,
+    bool exists) {
+  // The callback may destroy |this|, so it runs from copies.
+  const std::string uuid = uuid_;
+  RulesFileReadyCallback callback = rules_file_ready_callback_;
+  callback.Run(uuid, exists ? rules_file_path : base::FilePath());
+}
+
+}  // namespace brave_shields
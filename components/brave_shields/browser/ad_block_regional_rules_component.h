@@ -0,0 +1,58 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_REGIONAL_RULES_COMPONENT_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_REGIONAL_RULES_COMPONENT_H_
+
+#include <memory>
+#include <string>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "brave/components/brave_component_updater/browser/brave_component.h"
+
+namespace brave_shields {
+
+// Keeps the component of a regional filter list installed and reports where
+// its plain-text rules are, for AdBlockCombinedRegionalService. Unlike
+// AdBlockRegionalService it holds no engine of its own.
+class AdBlockRegionalRulesComponent
+    : public brave_component_updater::BraveComponent {
+ public:
+  // Called with the path of rs-<uuid>.txt, or with an empty path when the
+  // installed component does not ship plain-text rules.
+  using RulesFileReadyCallback =
+      base::RepeatingCallback<void(const std::string& uuid,
+                                   const base::FilePath& rules_file_path)>;
+
+  AdBlockRegionalRulesComponent(
+      const std::string& uuid,
+      brave_component_updater::BraveComponent::Delegate* delegate,
+      RulesFileReadyCallback callback);
+  ~AdBlockRegionalRulesComponent() override;
+
+  bool Init();
+
+ protected:
+  void OnComponentReady(const std::string& component_id,
+                        const base::FilePath& install_dir,
+                        const std::string& manifest) override;
+
+ private:
+  void OnRulesFileChecked(const base::FilePath& rules_file_path,
+                          bool exists);
+
+  std::string uuid_;
+  RulesFileReadyCallback rules_file_ready_callback_;
+  base::WeakPtrFactory<AdBlockRegionalRulesComponent> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockRegionalRulesComponent);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_REGIONAL_RULES_COMPONENT_H_
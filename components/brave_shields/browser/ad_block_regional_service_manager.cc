@@ -9,14 +9,18 @@
 #include <utility>
 #include <vector>
 
+#include "base/feature_list.h"
 #include "base/strings/string_util.h"
 #include "base/task/post_task.h"
 #include "base/values.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_shields/browser/ad_block_combined_regional_service.h"
+#include "brave/components/brave_shields/browser/ad_block_regional_rules_component.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
+#include "brave/components/brave_shields/common/features.h"
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
@@ -31,6 +35,11 @@ AdBlockRegionalServiceManager::AdBlockRegionalServiceManager(
     brave_component_updater::BraveComponent::Delegate* delegate)
     : delegate_(delegate),
       initialized_(false) {
+  if (base::FeatureList::IsEnabled(
+          features::kBraveAdblockCombinedRegionalLists)) {
+    combined_service_ = AdBlockCombinedRegionalServiceFactory(delegate_);
+    combined_service_->Start();
+  }
   if (Init()) {
     initialized_ = true;
   }
@@ -80,13 +89,49 @@ void AdBlockRegionalServiceManager::StartRegionalServices() {
     regional_filters_dict->GetDictionary(uuid, &regional_filter_dict);
     if (regional_filter_dict)
       regional_filter_dict->GetBoolean("enabled", &enabled);
-    if (enabled) {
-      auto regional_service = AdBlockRegionalServiceFactory(uuid, delegate_);
-      regional_service->Start();
-      regional_services_.insert(
-          std::make_pair(uuid, std::move(regional_service)));
-    }
+    if (enabled)
+      StartFilterList(uuid);
+  }
+}
+
+void AdBlockRegionalServiceManager::StartFilterList(const std::string& uuid) {
+  regional_services_lock_.AssertAcquired();
+  if (!combined_service_) {
+    auto regional_service = AdBlockRegionalServiceFactory(uuid, delegate_);
+    regional_service->Start();
+    regional_services_.insert(
+        std::make_pair(uuid, std::move(regional_service)));
+    return;
   }
+
+  auto rules_component = std::make_unique<AdBlockRegionalRulesComponent>(
+      uuid, delegate_,
+      base::BindRepeating(
+          &AdBlockRegionalServiceManager::OnRegionalRulesFileReady,
+          base::Unretained(this)));
+  rules_component->Init();
+  rules_components_.insert(std::make_pair(uuid, std::move(rules_component)));
+}
+
+void AdBlockRegionalServiceManager::OnRegionalRulesFileReady(
+    const std::string& uuid,
+    const base::FilePath& rules_file_path) {
+  DCHECK(combined_service_);
+  if (!rules_file_path.empty()) {
+    combined_service_->SetFilterListRulesFile(uuid, rules_file_path);
+    return;
+  }
+
+  // Lists shipped without plain-text rules can't be merged, so the list is
+  // handed over to a service loading its own DAT file, which registers the
+  // component in place of the rules component.
+  combined_service_->SetFilterListRulesFile(uuid, base::FilePath());
+  base::AutoLock lock(regional_services_lock_);
+  if (!rules_components_.erase(uuid))
+    return;
+  auto regional_service = AdBlockRegionalServiceFactory(uuid, delegate_);
+  regional_service->Start();
+  regional_services_.insert(std::make_pair(uuid, std::move(regional_service)));
 }
 
 void AdBlockRegionalServiceManager::UpdateFilterListPrefs(
@@ -109,6 +154,8 @@ bool AdBlockRegionalServiceManager::IsInitialized() const {
 
 bool AdBlockRegionalServiceManager::Start() {
   base::AutoLock lock(regional_services_lock_);
+  if (combined_service_)
+    combined_service_->Start();
   for (const auto& regional_service : regional_services_) {
     regional_service.second->Start();
   }
@@ -118,6 +165,8 @@ bool AdBlockRegionalServiceManager::Start() {
 
 void AdBlockRegionalServiceManager::Stop() {
   base::AutoLock lock(regional_services_lock_);
+  if (combined_service_)
+    combined_service_->Stop();
   for (const auto& regional_service : regional_services_) {
     regional_service.second->Stop();
   }
@@ -130,11 +179,32 @@ bool AdBlockRegionalServiceManager::ShouldStartRequest(
     bool* matching_exception_filter,
     bool* cancel_request_explicitly,
     std::string* mock_data_url) {
+  return ShouldStartRequest(AdBlockRequest(url, resource_type, tab_host),
+                            matching_exception_filter,
+                            cancel_request_explicitly, mock_data_url);
+}
+
+bool AdBlockRegionalServiceManager::ShouldStartRequest(
+    const AdBlockRequest& request,
+    bool* matching_exception_filter,
+    bool* cancel_request_explicitly,
+    std::string* mock_data_url) {
+  if (combined_service_) {
+    if (!combined_service_->ShouldStartRequest(
+            request, matching_exception_filter, cancel_request_explicitly,
+            mock_data_url)) {
+      return false;
+    }
+    if (matching_exception_filter && *matching_exception_filter) {
+      return true;
+    }
+  }
+
   base::AutoLock lock(regional_services_lock_);
   for (const auto& regional_service : regional_services_) {
     if (!regional_service.second->ShouldStartRequest(
-            url, resource_type, tab_host, matching_exception_filter,
-            cancel_request_explicitly, mock_data_url)) {
+            request, matching_exception_filter, cancel_request_explicitly,
+            mock_data_url)) {
       return false;
     }
     if (matching_exception_filter && *matching_exception_filter) {
@@ -148,6 +218,8 @@ bool AdBlockRegionalServiceManager::ShouldStartRequest(
 void AdBlockRegionalServiceManager::EnableTag(const std::string& tag,
                                               bool enabled) {
   base::AutoLock lock(regional_services_lock_);
+  if (combined_service_)
+    combined_service_->EnableTag(tag, enabled);
   for (const auto& regional_service : regional_services_) {
     regional_service.second->EnableTag(tag, enabled);
   }
@@ -156,6 +228,8 @@ void AdBlockRegionalServiceManager::EnableTag(const std::string& tag,
 void AdBlockRegionalServiceManager::AddResources(
     const std::string& resources) {
   base::AutoLock lock(regional_services_lock_);
+  if (combined_service_)
+    combined_service_->AddResources(resources);
   for (const auto& regional_service : regional_services_) {
     regional_service.second->AddResources(resources);
   }
@@ -171,15 +245,20 @@ void AdBlockRegionalServiceManager::EnableFilterList(const std::string& uuid,
     auto it = regional_services_.find(uuid);
     if (enabled) {
       DCHECK(it == regional_services_.end());
-      auto regional_service = AdBlockRegionalServiceFactory(uuid, delegate_);
-      regional_service->Start();
-      regional_services_.insert(
-          std::make_pair(uuid, std::move(regional_service)));
+      DCHECK(rules_components_.find(uuid) == rules_components_.end());
+      StartFilterList(uuid);
     } else {
-      DCHECK(it != regional_services_.end());
-      it->second->Stop();
-      it->second->Unregister();
-      regional_services_.erase(it);
+      auto rules_component_it = rules_components_.find(uuid);
+      if (rules_component_it != rules_components_.end()) {
+        rules_component_it->second->Unregister();
+        rules_components_.erase(rules_component_it);
+        combined_service_->SetFilterListRulesFile(uuid, base::FilePath());
+      } else {
+        DCHECK(it != regional_services_.end());
+        it->second->Stop();
+        it->second->Unregister();
+        regional_services_.erase(it);
+      }
     }
   }
 
@@ -230,6 +309,15 @@ AdBlockRegionalServiceManager::GetRegionalLists() {
     if (regional_filter_dict)
       regional_filter_dict->GetBoolean("enabled", &enabled);
     dict->SetBoolean("enabled", enabled);
+    // With a combined engine, report how many rules this list adds on top
+    // of the other enabled lists.
+    AdBlockRegionalServiceManager* manager =
+        g_brave_browser_process->ad_block_regional_service_manager();
+    if (enabled && manager && manager->combined_service_) {
+      dict->SetInteger("unique_rule_count",
+                       manager->combined_service_->GetUniqueRuleCount(
+                           region_list.uuid));
+    }
 
     list_value->Append(std::move(dict));
   }
@@ -27,7 +27,10 @@ using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
 
+class AdBlockCombinedRegionalService;
+class AdBlockRegionalRulesComponent;
 class AdBlockRegionalService;
+struct AdBlockRequest;
 
 // The AdBlock regional service manager, in charge of initializing and
 // managing regional AdBlock clients.
@@ -48,6 +51,10 @@ class AdBlockRegionalServiceManager {
                           bool* matching_exception_filter,
                           bool* cancel_request_explicitly,
                           std::string* mock_data_url);
+  bool ShouldStartRequest(const AdBlockRequest& request,
+                          bool* matching_exception_filter,
+                          bool* cancel_request_explicitly,
+                          std::string* mock_data_url);
   void EnableTag(const std::string& tag, bool enabled);
   void AddResources(const std::string& resources);
   void EnableFilterList(const std::string& uuid, bool enabled);
@@ -56,6 +63,9 @@ class AdBlockRegionalServiceManager {
   friend class ::AdBlockServiceTest;
   bool Init();
   void StartRegionalServices();
+  void StartFilterList(const std::string& uuid);
+  void OnRegionalRulesFileReady(const std::string& uuid,
+                                const base::FilePath& rules_file_path);
   void UpdateFilterListPrefs(const std::string& uuid, bool enabled);
 
   brave_component_updater::BraveComponent::Delegate* delegate_;  // NOT OWNED
@@ -63,6 +73,13 @@ class AdBlockRegionalServiceManager {
   base::Lock regional_services_lock_;
   std::map<std::string, std::unique_ptr<AdBlockRegionalService>>
       regional_services_;
+  // Only set when kBraveAdblockCombinedRegionalLists is enabled. Enabled
+  // lists then feed their rules to |combined_service_| through
+  // |rules_components_|, and only lists shipped without plain-text rules get
+  // an engine of their own in |regional_services_|.
+  std::unique_ptr<AdBlockCombinedRegionalService> combined_service_;
+  std::map<std::string, std::unique_ptr<AdBlockRegionalRulesComponent>>
+      rules_components_;
 
   DISALLOW_COPY_AND_ASSIGN(AdBlockRegionalServiceManager);
 };
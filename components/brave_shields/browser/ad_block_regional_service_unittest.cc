@@ -4,6 +4,7 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
+#include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 TEST(AdBlockRegionalServiceTest, UserModelLanguages) {
@@ -14,3 +15,35 @@ TEST(AdBlockRegionalServiceTest, UserModelLanguages) {
         language));
   });
 }
+
+TEST(AdBlockRegionalServiceTest, MergeFilterListsDropsDuplicates) {
+  std::map<std::string, std::string> filter_lists({
+      {"list-a", "[Adblock Plus 2.0]\n! Title: A\n||ads.example.com^\n"
+                 "##.banner\n"},
+      {"list-b", "||ads.example.com^\n  ##.banner  \n||tracker.example^\n"},
+  });
+  std::map<std::string, size_t> unique_rule_counts;
+  EXPECT_EQ(brave_shields::MergeFilterLists(filter_lists,
+                                            &unique_rule_counts),
+            "||ads.example.com^\n##.banner\n||tracker.example^\n");
+  EXPECT_EQ(unique_rule_counts["list-a"], 0UL);
+  EXPECT_EQ(unique_rule_counts["list-b"], 1UL);
+}
+
+TEST(AdBlockRegionalServiceTest, MergeFilterListsCountsIgnoreListOrder) {
+  const std::string rules_a = "||ads.example.com^\n||a.example^\n";
+  const std::string rules_b =
+      "||ads.example.com^\n||b.example^\n||b.example^\n||other.example^\n";
+  std::map<std::string, size_t> unique_rule_counts;
+  brave_shields::MergeFilterLists({{"list-a", rules_a}, {"list-b", rules_b}},
+                                  &unique_rule_counts);
+  EXPECT_EQ(unique_rule_counts["list-a"], 1UL);
+  EXPECT_EQ(unique_rule_counts["list-b"], 2UL);
+
+  // The same lists under keys sorting the other way round.
+  unique_rule_counts.clear();
+  brave_shields::MergeFilterLists({{"list-z", rules_a}, {"list-b", rules_b}},
+                                  &unique_rule_counts);
+  EXPECT_EQ(unique_rule_counts["list-z"], 1UL);
+  EXPECT_EQ(unique_rule_counts["list-b"], 2UL);
+}
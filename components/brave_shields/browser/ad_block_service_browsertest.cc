@@ -3,6 +3,8 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <memory>
+
 #include "base/path_service.h"
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
@@ -14,6 +16,7 @@
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/brave_shields/common/features.h"
@@ -77,6 +80,15 @@ class AdBlockServiceTest : public ExtensionBrowserTest {
   void SetUpOnMainThread() override {
     ExtensionBrowserTest::SetUpOnMainThread();
     host_resolver()->AddRule("*", "127.0.0.1");
+    // Pref counters are checked right after each blocked request.
+    flush_blocked_events_immediately_ = std::make_unique<
+        brave_shields::BraveShieldsWebContentsObserver::
+            ScopedFlushBlockedEventsImmediatelyForTesting>();
+  }
+
+  void TearDownOnMainThread() override {
+    flush_blocked_events_immediately_.reset();
+    ExtensionBrowserTest::TearDownOnMainThread();
   }
 
   void SetUp() override {
@@ -231,6 +243,11 @@ class AdBlockServiceTest : public ExtensionBrowserTest {
         false);
     ASSERT_TRUE(extension_listener.WaitUntilSatisfied());
   }
+
+ private:
+  std::unique_ptr<brave_shields::BraveShieldsWebContentsObserver::
+                      ScopedFlushBlockedEventsImmediatelyForTesting>
+      flush_blocked_events_immediately_;
 };
 
 // Load a page with an ad image, and make sure it is blocked.
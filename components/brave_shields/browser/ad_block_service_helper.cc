@@ -6,7 +6,10 @@
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 
 #include <algorithm>
+#include <unordered_map>
 
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 
 using adblock::FilterList;
@@ -44,4 +47,42 @@ std::vector<FilterList>::const_iterator FindAdBlockFilterListByLocale(
       });
 }
 
+std::string MergeFilterLists(
+    const std::map<std::string, std::string>& filter_lists,
+    std::map<std::string, size_t>* unique_rule_counts) {
+  std::string merged_rules;
+  // Each rule maps to the UUID of the only list containing it, or to null
+  // once a second list contains it too.
+  std::unordered_map<base::StringPiece, const std::string*,
+                     base::StringPieceHash>
+      rule_owners;
+  for (const auto& filter_list : filter_lists) {
+    for (const base::StringPiece& rule : base::SplitStringPiece(
+             filter_list.second, "\n", base::TRIM_WHITESPACE,
+             base::SPLIT_WANT_NONEMPTY)) {
+      // Skip comments and the [Adblock Plus x.y] header.
+      if (rule[0] == '!' || rule[0] == '[')
+        continue;
+      auto result = rule_owners.emplace(rule, &filter_list.first);
+      if (!result.second) {
+        if (result.first->second != &filter_list.first)
+          result.first->second = nullptr;
+        continue;
+      }
+      rule.AppendToString(&merged_rules);
+      merged_rules.push_back('\n');
+    }
+  }
+
+  if (unique_rule_counts) {
+    for (const auto& filter_list : filter_lists)
+      (*unique_rule_counts)[filter_list.first] = 0;
+    for (const auto& rule_owner : rule_owners) {
+      if (rule_owner.second)
+        (*unique_rule_counts)[*rule_owner.second]++;
+    }
+  }
+  return merged_rules;
+}
+
 }  // namespace brave_shields
@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_SERVICE_HELPER_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_SERVICE_HELPER_H_
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -20,6 +21,14 @@ std::vector<adblock::FilterList>::const_iterator FindAdBlockFilterListByLocale(
     const std::vector<adblock::FilterList>& region_lists,
     const std::string& locale);
 
+// Merges the rules of several filter lists, keyed by list UUID, into one
+// list with duplicate rules and comments removed. The number of rules of
+// each list that no other list contains is written to |unique_rule_counts|,
+// so it doesn't depend on the order of the lists.
+std::string MergeFilterLists(
+    const std::map<std::string, std::string>& filter_lists,
+    std::map<std::string, size_t>* unique_rule_counts);
+
 }  // namespace brave_shields
 
 #endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_SERVICE_HELPER_H_
@@ -11,10 +11,13 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
 #include "brave/common/render_messages.h"
+#include "brave/components/brave_perf_predictor/browser/buildflags.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/browser/renderer_content_setting_rules_sender.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/content/common/frame_messages.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
@@ -36,6 +39,10 @@
 #include "extensions/buildflags/buildflags.h"
 #include "ipc/ipc_message_macros.h"
 
+#if BUILDFLAG(ENABLE_BRAVE_PERF_PREDICTOR)
+#include "brave/components/brave_perf_predictor/browser/perf_predictor_tab_helper.h"
+#endif
+
 #if BUILDFLAG(ENABLE_EXTENSIONS)
 #include "brave/common/extensions/api/brave_shields.h"
 #include "chrome/browser/extensions/extension_tab_util.h"
@@ -52,6 +59,12 @@ using content::WebContents;
 
 namespace {
 
+// How long blocked events are buffered before being dispatched together.
+constexpr base::TimeDelta kBlockedEventsFlushDelay =
+    base::TimeDelta::FromMilliseconds(100);
+
+bool g_flush_blocked_events_immediately_for_testing = false;
+
 // Content Settings are only sent to the main frame currently.
 // Chrome may fix this at some point, but for now we do this as a work-around.
 // You can verify if this is fixed by running the following test:
@@ -61,22 +74,11 @@ namespace {
 // tests by:
 // npm run test -- brave_browser_tests --filter=BraveContentSettingsAgentImplBrowserTest.*  // NOLINT
 void UpdateContentSettingsToRendererFrames(content::WebContents* web_contents) {
-  for (content::RenderFrameHost* frame : web_contents->GetAllFrames()) {
-    Profile* profile =
-        Profile::FromBrowserContext(web_contents->GetBrowserContext());
-    const HostContentSettingsMap* map =
-        HostContentSettingsMapFactory::GetForProfile(profile);
-    RendererContentSettingRules rules;
-    GetRendererContentSettingRules(map, &rules);
-    IPC::ChannelProxy* channel =
-        frame->GetProcess()->GetChannel();
-    // channel might be NULL in tests.
-    if (channel) {
-      chrome::mojom::RendererConfigurationAssociatedPtr rc_interface;
-      channel->GetRemoteAssociatedInterface(&rc_interface);
-      rc_interface->SetContentSettingRules(rules);
-    }
-  }
+  brave_shields::RendererContentSettingRulesSender* sender =
+      brave_shields::RendererContentSettingRulesSender::FromProfile(
+          Profile::FromBrowserContext(web_contents->GetBrowserContext()));
+  for (content::RenderFrameHost* frame : web_contents->GetAllFrames())
+    sender->MaybeSendTo(frame->GetProcess());
 }
 
 WebContents* GetWebContents(
@@ -132,6 +134,17 @@ bool BraveShieldsWebContentsObserver::RenderFrameIdKey::operator==(
 BraveShieldsWebContentsObserver::~BraveShieldsWebContentsObserver() {
 }
 
+BraveShieldsWebContentsObserver::ScopedFlushBlockedEventsImmediatelyForTesting::
+    ScopedFlushBlockedEventsImmediatelyForTesting()
+    : previous_value_(g_flush_blocked_events_immediately_for_testing) {
+  g_flush_blocked_events_immediately_for_testing = true;
+}
+
+BraveShieldsWebContentsObserver::ScopedFlushBlockedEventsImmediatelyForTesting::
+    ~ScopedFlushBlockedEventsImmediatelyForTesting() {
+  g_flush_blocked_events_immediately_for_testing = previous_value_;
+}
+
 BraveShieldsWebContentsObserver::BraveShieldsWebContentsObserver(
     WebContents* web_contents)
     : WebContentsObserver(web_contents) {
@@ -174,6 +187,16 @@ void BraveShieldsWebContentsObserver::RenderFrameHostChanged(
   }
 }
 
+void BraveShieldsWebContentsObserver::DidStartNavigation(
+    content::NavigationHandle* navigation_handle) {
+  // Deliver what the previous page blocked before observers reset per-page
+  // state.
+  if (navigation_handle->IsInMainFrame() &&
+      !navigation_handle->IsSameDocument()) {
+    FlushBlockedEvents();
+  }
+}
+
 void BraveShieldsWebContentsObserver::DidFinishNavigation(
     content::NavigationHandle* navigation_handle) {
   RenderFrameHost* main_frame = web_contents()->GetMainFrame();
@@ -230,32 +253,97 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
 
   WebContents* web_contents = GetWebContents(render_process_id,
     render_frame_id, frame_tree_node_id);
-  DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
+  if (!web_contents) {
+    return;
+  }
+  BraveShieldsWebContentsObserver* observer =
+      BraveShieldsWebContentsObserver::FromWebContents(web_contents);
+  if (observer) {
+    observer->AddBlockedEvent(block_type, subresource);
+  }
+}
 
-  if (web_contents) {
-    BraveShieldsWebContentsObserver* observer =
-        BraveShieldsWebContentsObserver::FromWebContents(web_contents);
-    if (observer &&
-        !observer->IsBlockedSubresource(subresource)) {
-      observer->AddBlockedSubresource(subresource);
-      PrefService* prefs = Profile::FromBrowserContext(
-          web_contents->GetBrowserContext())->
-          GetOriginalProfile()->
-          GetPrefs();
-
-      if (block_type == kAds) {
-        prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
-      } else if (block_type == kHTTPUpgradableResources) {
-        prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
-      } else if (block_type == kJavaScript) {
-        prefs->SetUint64(kJavascriptBlocked,
-            prefs->GetUint64(kJavascriptBlocked) + 1);
-      } else if (block_type == kFingerprinting) {
-        prefs->SetUint64(kFingerprintingBlocked,
-            prefs->GetUint64(kFingerprintingBlocked) + 1);
-      }
+void BraveShieldsWebContentsObserver::AddBlockedEvent(
+    const std::string& block_type,
+    const std::string& subresource) {
+  pending_blocked_events_.push_back({block_type, subresource});
+  if (g_flush_blocked_events_immediately_for_testing) {
+    FlushBlockedEvents();
+    return;
+  }
+  if (!flush_blocked_events_timer_.IsRunning()) {
+    flush_blocked_events_timer_.Start(
+        FROM_HERE, kBlockedEventsFlushDelay,
+        base::BindOnce(&BraveShieldsWebContentsObserver::FlushBlockedEvents,
+                       base::Unretained(this)));
+  }
+}
+
+// Pages blocking hundreds of subresources would otherwise cost one extension
+// event and one pref write each.
+void BraveShieldsWebContentsObserver::FlushBlockedEvents() {
+  flush_blocked_events_timer_.Stop();
+  if (pending_blocked_events_.empty()) {
+    return;
+  }
+  std::vector<BlockedEvent> events;
+  events.swap(pending_blocked_events_);
+
+  DispatchBlockedEventsForWebContents(events, web_contents());
+
+  uint64_t ads_blocked = 0;
+  uint64_t https_upgrades = 0;
+  uint64_t javascript_blocked = 0;
+  uint64_t fingerprinting_blocked = 0;
+  for (const BlockedEvent& event : events) {
+    if (IsBlockedSubresource(event.subresource)) {
+      continue;
+    }
+    AddBlockedSubresource(event.subresource);
+    if (event.block_type == kAds) {
+      ads_blocked++;
+    } else if (event.block_type == kHTTPUpgradableResources) {
+      https_upgrades++;
+    } else if (event.block_type == kJavaScript) {
+      javascript_blocked++;
+    } else if (event.block_type == kFingerprinting) {
+      fingerprinting_blocked++;
+    }
+  }
+
+  PrefService* prefs = Profile::FromBrowserContext(
+      web_contents()->GetBrowserContext())->
+      GetOriginalProfile()->
+      GetPrefs();
+  if (ads_blocked) {
+    prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + ads_blocked);
+  }
+  if (https_upgrades) {
+    prefs->SetUint64(kHttpsUpgrades,
+        prefs->GetUint64(kHttpsUpgrades) + https_upgrades);
+  }
+  if (javascript_blocked) {
+    prefs->SetUint64(kJavascriptBlocked,
+        prefs->GetUint64(kJavascriptBlocked) + javascript_blocked);
+  }
+  if (fingerprinting_blocked) {
+    prefs->SetUint64(kFingerprintingBlocked,
+        prefs->GetUint64(kFingerprintingBlocked) + fingerprinting_blocked);
+  }
+
+#if BUILDFLAG(ENABLE_BRAVE_PERF_PREDICTOR)
+  brave_perf_predictor::PerfPredictorTabHelper* perf_predictor =
+      brave_perf_predictor::PerfPredictorTabHelper::FromWebContents(
+          web_contents());
+  if (perf_predictor) {
+    std::vector<std::string> subresources;
+    subresources.reserve(events.size());
+    for (const BlockedEvent& event : events) {
+      subresources.push_back(event.subresource);
     }
+    perf_predictor->OnBlockedSubresources(subresources);
   }
+#endif
 }
 
 #if !defined(OS_ANDROID)
@@ -271,7 +359,7 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
       Profile::FromBrowserContext(web_contents->GetBrowserContext());
   EventRouter* event_router = EventRouter::Get(profile);
   if (profile && event_router) {
-    extensions::api::brave_shields::OnBlocked::Details details;
+    extensions::api::brave_shields::BlockedDetails details;
     details.tab_id = extensions::ExtensionTabUtil::GetTabId(web_contents);
     details.block_type = block_type;
     details.subresource = subresource;
@@ -286,6 +374,40 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
   }
 #endif
 }
+
+// static
+void BraveShieldsWebContentsObserver::DispatchBlockedEventsForWebContents(
+    const std::vector<BlockedEvent>& events,
+    WebContents* web_contents) {
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+  if (!web_contents) {
+    return;
+  }
+  Profile* profile =
+      Profile::FromBrowserContext(web_contents->GetBrowserContext());
+  EventRouter* event_router = EventRouter::Get(profile);
+  if (profile && event_router) {
+    const int tab_id = extensions::ExtensionTabUtil::GetTabId(web_contents);
+    std::vector<extensions::api::brave_shields::BlockedDetails> details;
+    details.reserve(events.size());
+    for (const BlockedEvent& event : events) {
+      extensions::api::brave_shields::BlockedDetails event_details;
+      event_details.tab_id = tab_id;
+      event_details.block_type = event.block_type;
+      event_details.subresource = event.subresource;
+      details.push_back(std::move(event_details));
+    }
+    std::unique_ptr<base::ListValue> args(
+        extensions::api::brave_shields::OnBlockedBatch::Create(details)
+          .release());
+    std::unique_ptr<Event> event(
+        new Event(extensions::events::BRAVE_AD_BLOCKED,
+          extensions::api::brave_shields::OnBlockedBatch::kEventName,
+          std::move(args)));
+    event_router->BroadcastEvent(std::move(event));
+  }
+#endif
+}
 #endif
 
 bool BraveShieldsWebContentsObserver::OnMessageReceived(
@@ -342,6 +464,7 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
   if (navigation_handle->IsInMainFrame() &&
       !navigation_handle->IsSameDocument() &&
       navigation_handle->GetReloadType() == content::ReloadType::NONE) {
+    FlushBlockedEvents();
     allowed_script_origins_.clear();
     blocked_url_paths_.clear();
   }
@@ -356,6 +479,10 @@ void BraveShieldsWebContentsObserver::AllowScriptsOnce(
   allowed_script_origins_ = std::move(origins);
 }
 
+void BraveShieldsWebContentsObserver::WebContentsDestroyed() {
+  FlushBlockedEvents();
+}
+
 WEB_CONTENTS_USER_DATA_KEY_IMPL(BraveShieldsWebContentsObserver)
 
 }  // namespace brave_shields
@@ -14,6 +14,7 @@
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
 #include "base/strings/string16.h"
+#include "base/timer/timer.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 
@@ -31,11 +32,21 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
   explicit BraveShieldsWebContentsObserver(content::WebContents*);
   ~BraveShieldsWebContentsObserver() override;
 
+  struct BlockedEvent {
+    std::string block_type;
+    std::string subresource;
+  };
+
   static void RegisterProfilePrefs(PrefRegistrySimple* registry);
   static void DispatchBlockedEventForWebContents(
       const std::string& block_type,
       const std::string& subresource,
       content::WebContents* web_contents);
+  static void DispatchBlockedEventsForWebContents(
+      const std::vector<BlockedEvent>& events,
+      content::WebContents* web_contents);
+  // Buffers the event; buffered events are flushed together after a short
+  // delay.
   static void DispatchBlockedEvent(
       std::string block_type,
       std::string subresource,
@@ -48,6 +59,20 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
                         content::WebContents* web_contents);
   bool IsBlockedSubresource(const std::string& subresource);
   void AddBlockedSubresource(const std::string& subresource);
+  void FlushBlockedEvents();
+
+  // Blocked events are dispatched as they arrive while this is alive, for
+  // tests checking the counters right after a request.
+  class ScopedFlushBlockedEventsImmediatelyForTesting {
+   public:
+    ScopedFlushBlockedEventsImmediatelyForTesting();
+    ~ScopedFlushBlockedEventsImmediatelyForTesting();
+
+   private:
+    const bool previous_value_;
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedFlushBlockedEventsImmediatelyForTesting);
+  };
 
  protected:
     // A set of identifiers that uniquely identifies a RenderFrame.
@@ -72,8 +97,11 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
                               content::RenderFrameHost* new_host) override;
   void ReadyToCommitNavigation(
       content::NavigationHandle* navigation_handle) override;
+  void DidStartNavigation(
+      content::NavigationHandle* navigation_handle) override;
   void DidFinishNavigation(
       content::NavigationHandle* navigation_handle) override;
+  void WebContentsDestroyed() override;
 
   // Invoked if an IPC message is coming from a specific RenderFrameHost.
   bool OnMessageReceived(const IPC::Message& message,
@@ -94,10 +122,17 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
 
  private:
   friend class content::WebContentsUserData<BraveShieldsWebContentsObserver>;
+
+  void AddBlockedEvent(const std::string& block_type,
+                       const std::string& subresource);
+
   std::vector<std::string> allowed_script_origins_;
   // We keep a set of the current page's blocked URLs in case the page
   // continually tries to load the same blocked URLs.
   std::set<std::string> blocked_url_paths_;
+  // Blocked events waiting for |flush_blocked_events_timer_|.
+  std::vector<BlockedEvent> pending_blocked_events_;
+  base::OneShotTimer flush_blocked_events_timer_;
 
   WEB_CONTENTS_USER_DATA_KEY_DECL();
   DISALLOW_COPY_AND_ASSIGN(BraveShieldsWebContentsObserver);
@@ -6,6 +6,7 @@
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 
 #include <string>
+#include <vector>
 
 #include "brave/browser/android/brave_shields_content_settings.h"
 #include "chrome/browser/android/tab_android.h"
@@ -33,4 +34,14 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
       tabId, block_type, subresource);
 }
 
+// static
+void BraveShieldsWebContentsObserver::DispatchBlockedEventsForWebContents(
+    const std::vector<BlockedEvent>& events,
+    WebContents* web_contents) {
+  for (const BlockedEvent& event : events) {
+    DispatchBlockedEventForWebContents(event.block_type, event.subresource,
+                                       web_contents);
+  }
+}
+
 }  // namespace brave_shields
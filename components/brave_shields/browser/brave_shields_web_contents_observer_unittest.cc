@@ -0,0 +1,115 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "brave/common/pref_names.h"
+#include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "chrome/browser/prefs/browser_prefs.h"
+#include "chrome/test/base/testing_profile.h"
+#include "components/prefs/pref_service.h"
+#include "components/sync_preferences/testing_pref_service_syncable.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/test/test_renderer_host.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave_shields::BraveShieldsWebContentsObserver;
+
+class BraveShieldsWebContentsObserverTest
+    : public content::RenderViewHostTestHarness {
+ protected:
+  BraveShieldsWebContentsObserverTest()
+      : content::RenderViewHostTestHarness(
+            base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
+
+  void SetUp() override {
+    content::RenderViewHostTestHarness::SetUp();
+    BraveShieldsWebContentsObserver::CreateForWebContents(web_contents());
+    NavigateAndCommit(GURL("https://brave.com/"));
+  }
+
+  std::unique_ptr<content::BrowserContext> CreateBrowserContext() override {
+    TestingProfile::Builder builder;
+    auto prefs =
+        std::make_unique<sync_preferences::TestingPrefServiceSyncable>();
+    RegisterUserProfilePrefs(prefs->registry());
+    builder.SetPrefService(std::move(prefs));
+    return builder.Build();
+  }
+
+  void DispatchBlockedAd(const std::string& subresource) {
+    BraveShieldsWebContentsObserver::DispatchBlockedEvent(
+        brave_shields::kAds, subresource, -1, -1,
+        main_rfh()->GetFrameTreeNodeId());
+  }
+
+  uint64_t ads_blocked() {
+    return static_cast<TestingProfile*>(browser_context())
+        ->GetPrefs()
+        ->GetUint64(kAdsBlocked);
+  }
+};
+
+TEST_F(BraveShieldsWebContentsObserverTest, BlockedEventsAreBatched) {
+  DispatchBlockedAd("https://ads.example.com/a.js");
+  DispatchBlockedAd("https://ads.example.com/b.js");
+  DispatchBlockedAd("https://ads.example.com/a.js");
+  EXPECT_EQ(0u, ads_blocked());
+
+  task_environment()->FastForwardBy(base::TimeDelta::FromMilliseconds(99));
+  EXPECT_EQ(0u, ads_blocked());
+
+  task_environment()->FastForwardBy(base::TimeDelta::FromMilliseconds(1));
+  // The repeated subresource is only counted once per page.
+  EXPECT_EQ(2u, ads_blocked());
+
+  DispatchBlockedAd("https://ads.example.com/a.js");
+  task_environment()->FastForwardBy(base::TimeDelta::FromMilliseconds(100));
+  EXPECT_EQ(2u, ads_blocked());
+}
+
+TEST_F(BraveShieldsWebContentsObserverTest, BlockedEventsFlushOnNavigation) {
+  DispatchBlockedAd("https://ads.example.com/a.js");
+  EXPECT_EQ(0u, ads_blocked());
+
+  NavigateAndCommit(GURL("https://example.com/"));
+  EXPECT_EQ(1u, ads_blocked());
+
+  // The new page counts its own blocked subresources again.
+  DispatchBlockedAd("https://ads.example.com/a.js");
+  task_environment()->FastForwardBy(base::TimeDelta::FromMilliseconds(100));
+  EXPECT_EQ(2u, ads_blocked());
+}
+
+TEST_F(BraveShieldsWebContentsObserverTest, BlockedEventsFlushOnDestruction) {
+  DispatchBlockedAd("https://ads.example.com/a.js");
+  DispatchBlockedAd("https://ads.example.com/b.js");
+  EXPECT_EQ(0u, ads_blocked());
+
+  DeleteContents();
+  EXPECT_EQ(2u, ads_blocked());
+}
+
+TEST_F(BraveShieldsWebContentsObserverTest, ScopedFlushImmediately) {
+  {
+    BraveShieldsWebContentsObserver::
+        ScopedFlushBlockedEventsImmediatelyForTesting flush_immediately;
+    DispatchBlockedAd("https://ads.example.com/a.js");
+    EXPECT_EQ(1u, ads_blocked());
+  }
+
+  // Batching is back once the setter goes out of scope.
+  DispatchBlockedAd("https://ads.example.com/b.js");
+  EXPECT_EQ(1u, ads_blocked());
+  task_environment()->FastForwardBy(base::TimeDelta::FromMilliseconds(100));
+  EXPECT_EQ(2u, ads_blocked());
+}
@@ -6,40 +6,107 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RECENTLY_USED_CACHE_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RECENTLY_USED_CACHE_H_
 
+#include <algorithm>
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "base/containers/mru_cache.h"
 #include "base/synchronization/lock.h"
+#include "base/time/time.h"
 
+// An MRU cache split into independently locked shards, so lookups from
+// different threads rarely contend. Besides values it can remember that a
+// key has no value; such negative entries expire after |negative_ttl|.
 template <class T> class HTTPSERecentlyUsedCache {
  public:
-  explicit HTTPSERecentlyUsedCache(size_t size = 100) : data_(size) {}
+  enum class Lookup { kMiss, kHit, kNegativeHit };
+
+  explicit HTTPSERecentlyUsedCache(
+      size_t size = 100,
+      size_t shard_count = 1,
+      base::TimeDelta negative_ttl = base::TimeDelta::FromHours(1))
+      : negative_ttl_(negative_ttl) {
+    shard_count = std::max<size_t>(shard_count, 1);
+    const size_t shard_size = std::max<size_t>(size / shard_count, 1);
+    for (size_t i = 0; i < shard_count; ++i)
+      shards_.push_back(std::make_unique<Shard>(shard_size));
+  }
 
   void add(const std::string& key, const T& value) {
-    base::AutoLock create(lock_);
-    data_.Put(key, value);
+    Shard* shard = GetShard(key);
+    base::AutoLock create(shard->lock);
+    shard->data.Put(key, Entry(value));
   }
 
-  bool get(const std::string& key, T* value) {
-    base::AutoLock create(lock_);
-    auto it = data_.Get(key);
-    if (it != data_.end()) {
-      *value = it->second;
-      return true;
+  // Records that |key| has no value.
+  void add_negative(const std::string& key) {
+    Shard* shard = GetShard(key);
+    base::AutoLock create(shard->lock);
+    shard->data.Put(key, Entry(base::TimeTicks::Now() + negative_ttl_));
+  }
+
+  Lookup lookup(const std::string& key, T* value) {
+    Shard* shard = GetShard(key);
+    base::AutoLock create(shard->lock);
+    auto it = shard->data.Get(key);
+    if (it == shard->data.end())
+      return Lookup::kMiss;
+    if (it->second.is_negative) {
+      if (it->second.expiry <= base::TimeTicks::Now()) {
+        shard->data.Erase(it);
+        return Lookup::kMiss;
+      }
+      return Lookup::kNegativeHit;
     }
-    return false;
+    *value = it->second.value;
+    return Lookup::kHit;
+  }
+
+  bool get(const std::string& key, T* value) {
+    return lookup(key, value) == Lookup::kHit;
   }
 
   void remove(const std::string& key) {
-    base::AutoLock lock(lock_);
-    auto it = data_.Peek(key);
-    if (it != data_.end())
-      data_.Erase(it);
+    Shard* shard = GetShard(key);
+    base::AutoLock lock(shard->lock);
+    auto it = shard->data.Peek(key);
+    if (it != shard->data.end())
+      shard->data.Erase(it);
+  }
+
+  void clear() {
+    for (const auto& shard : shards_) {
+      base::AutoLock lock(shard->lock);
+      shard->data.Clear();
+    }
   }
 
  private:
-  base::MRUCache<std::string, T> data_;
-  base::Lock lock_;
+  struct Entry {
+    explicit Entry(const T& value) : value(value), is_negative(false) {}
+    explicit Entry(base::TimeTicks expiry)
+        : value(), is_negative(true), expiry(expiry) {}
+
+    T value;
+    bool is_negative;
+    base::TimeTicks expiry;
+  };
+
+  struct Shard {
+    explicit Shard(size_t size) : data(size) {}
+
+    base::MRUCache<std::string, Entry> data;
+    base::Lock lock;
+  };
+
+  Shard* GetShard(const std::string& key) {
+    return shards_[std::hash<std::string>()(key) % shards_.size()].get();
+  }
+
+  const base::TimeDelta negative_ttl_;
+  std::vector<std::unique_ptr<Shard>> shards_;
 };
 
 #endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RECENTLY_USED_CACHE_H_
@@ -5,6 +5,7 @@
 
 #include <string>
 
+#include "base/time/time.h"
 #include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -28,3 +29,53 @@ TEST(HTTPSEverywhereRecentlyUsedCacheTest, Operations) {
   cache.remove("kD");
   ASSERT_FALSE(cache.get("kD", &v));
 }
+
+TEST(HTTPSEverywhereRecentlyUsedCacheTest, NegativeEntries) {
+  using Cache = HTTPSERecentlyUsedCache<std::string>;
+  Cache cache(10, 2, base::TimeDelta::FromHours(1));
+  std::string v;
+
+  cache.add_negative("kA");
+  EXPECT_EQ(cache.lookup("kA", &v), Cache::Lookup::kNegativeHit);
+  EXPECT_FALSE(cache.get("kA", &v));
+  cache.add("kA", "vA");
+  EXPECT_EQ(cache.lookup("kA", &v), Cache::Lookup::kHit);
+  EXPECT_EQ(v, "vA");
+
+  // Expired negative entries are misses.
+  Cache expiring_cache(10, 2, base::TimeDelta());
+  expiring_cache.add_negative("kB");
+  EXPECT_EQ(expiring_cache.lookup("kB", &v), Cache::Lookup::kMiss);
+}
+
+// Replays a synthetic browsing trace in which a few popular hosts get most
+// of the requests. About two thirds of the lookups go to the 1000 most
+// popular hosts, which fit in the cache, so well over half should hit.
+TEST(HTTPSEverywhereRecentlyUsedCacheTest, HitRateOnSkewedTrace) {
+  using Cache = HTTPSERecentlyUsedCache<std::string>;
+  Cache cache(1000, 8, base::TimeDelta::FromHours(1));
+
+  const size_t kLookups = 100000;
+  const size_t kHosts = 5000;
+  uint32_t seed = 1;
+  std::string v;
+  size_t hits = 0;
+  for (size_t i = 0; i < kLookups; ++i) {
+    seed = seed * 1103515245 + 12345;
+    // A uniform value to the fourth power skews the trace toward low host
+    // numbers, roughly like real browsing.
+    double uniform = static_cast<double>((seed >> 8) % 10000) / 10000;
+    double skewed = uniform * uniform * uniform * uniform;
+    const std::string host =
+        "host" + std::to_string(static_cast<size_t>(skewed * kHosts)) +
+        ".example";
+    if (cache.lookup(host, &v) == Cache::Lookup::kMiss) {
+      cache.add_negative(host);
+    } else {
+      hits++;
+    }
+  }
+
+  const double hit_rate = static_cast<double>(hits) / kLookups;
+  EXPECT_GT(hit_rate, 0.5);
+}
@@ -0,0 +1,277 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/strings/string_split.h"
+#include "base/values.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace {
+
+// Rules use JavaScript style $1 references, RE2 wants \1.
+std::string CorrectToRuleToRE2Engine(const std::string& to) {
+  std::string corrected_to(to);
+  size_t pos = corrected_to.find("$");
+  while (std::string::npos != pos) {
+    corrected_to[pos] = '\\';
+    pos = corrected_to.find("$", pos + 1);
+  }
+  return corrected_to;
+}
+
+std::vector<std::string> SplitLabels(const std::string& host) {
+  std::vector<std::string> labels = base::SplitString(
+      host, ".", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
+  // "www.foo.com." has the same labels as "www.foo.com".
+  if (!labels.empty() && labels.back().empty())
+    labels.pop_back();
+  return labels;
+}
+
+}  // namespace
+
+namespace brave_shields {
+
+HTTPSEverywhereRuleset::RuleSet::RuleSet() = default;
+HTTPSEverywhereRuleset::RuleSet::RuleSet(RuleSet&& other) = default;
+HTTPSEverywhereRuleset::RuleSet::~RuleSet() = default;
+
+HTTPSEverywhereRuleset::Node::Node() = default;
+HTTPSEverywhereRuleset::Node::Node(Node&& other) = default;
+HTTPSEverywhereRuleset::Node::~Node() = default;
+
+HTTPSEverywhereRuleset::HTTPSEverywhereRuleset() : nodes_(1) {}
+
+HTTPSEverywhereRuleset::~HTTPSEverywhereRuleset() {
+  if (!regexes_)
+    return;
+  for (size_t i = 0; i < patterns_.size(); ++i)
+    delete regexes_[i].load(std::memory_order_relaxed);
+}
+
+bool HTTPSEverywhereRuleset::AddEntry(const std::string& key,
+                                      const std::string& value) {
+  std::vector<std::string> labels = base::SplitString(
+      key, ".", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
+  bool is_wildcard = !labels.empty() && labels.back() == "*";
+  if (is_wildcard)
+    labels.pop_back();
+  // Lookups never produce keys for a bare TLD or with inner wildcards.
+  if (labels.size() < 2)
+    return false;
+  for (const auto& label : labels) {
+    if (label.empty() || label.find('*') != std::string::npos)
+      return false;
+  }
+
+  uint32_t entry_index;
+  auto entry_it = entry_indices_.find(value);
+  if (entry_it != entry_indices_.end()) {
+    entry_index = entry_it->second;
+  } else {
+    Entry entry;
+    if (!ParseEntry(value, &entry))
+      return false;
+    entry_index = entries_.size();
+    entries_.push_back(std::move(entry));
+    entry_indices_[value] = entry_index;
+  }
+
+  uint32_t node_index = 0;
+  for (const auto& label : labels) {
+    auto child = nodes_[node_index].children.find(label);
+    if (child != nodes_[node_index].children.end()) {
+      node_index = child->second;
+      continue;
+    }
+    uint32_t child_index = nodes_.size();
+    nodes_[node_index].children[label] = child_index;
+    nodes_.emplace_back();
+    node_index = child_index;
+  }
+
+  if (is_wildcard) {
+    nodes_[node_index].wildcard_entry = entry_index;
+  } else {
+    nodes_[node_index].exact_entry = entry_index;
+  }
+  return true;
+}
+
+void HTTPSEverywhereRuleset::FinishBuilding() {
+  entry_indices_.clear();
+  pattern_indices_.clear();
+  nodes_.shrink_to_fit();
+  entries_.shrink_to_fit();
+  patterns_.shrink_to_fit();
+  regexes_.reset(new std::atomic<re2::RE2*>[patterns_.size()]());
+}
+
+std::string HTTPSEverywhereRuleset::GetHTTPSURL(const std::string& host,
+                                                const std::string& url) const {
+  return ApplyHostEntries(GetHostEntries(host), url);
+}
+
+std::vector<uint32_t> HTTPSEverywhereRuleset::GetHostEntries(
+    const std::string& host) const {
+  std::vector<uint32_t> candidates;
+  const std::vector<std::string> labels = SplitLabels(host);
+  const size_t count = labels.size();
+  if (count < 2)
+    return candidates;
+
+  // Candidates are tried in the same order as the database lookups: the
+  // exact host, then wildcards from the longest suffix to the shortest,
+  // skipping the TLD.
+  uint32_t exact_entry = kNoEntry;
+  uint32_t node_index = 0;
+  for (size_t depth = 1; depth <= count; ++depth) {
+    const Node& node = nodes_[node_index];
+    auto child = node.children.find(labels[count - depth]);
+    if (child == node.children.end())
+      break;
+    node_index = child->second;
+    const Node& child_node = nodes_[node_index];
+    if (depth == count) {
+      exact_entry = child_node.exact_entry;
+    } else if (depth >= 2 && child_node.wildcard_entry != kNoEntry) {
+      candidates.push_back(child_node.wildcard_entry);
+    }
+  }
+  if (exact_entry != kNoEntry)
+    candidates.push_back(exact_entry);
+  std::reverse(candidates.begin(), candidates.end());
+  return candidates;
+}
+
+std::string HTTPSEverywhereRuleset::ApplyHostEntries(
+    const std::vector<uint32_t>& entry_ids,
+    const std::string& url) const {
+  for (uint32_t entry_id : entry_ids) {
+    DCHECK_LT(entry_id, entries_.size());
+    std::string new_url = ApplyEntry(entries_[entry_id], url);
+    if (!new_url.empty())
+      return new_url;
+  }
+  return std::string();
+}
+
+bool HTTPSEverywhereRuleset::ParseEntry(const std::string& value,
+                                        Entry* entry) {
+  base::Optional<base::Value> json_object = base::JSONReader::Read(value);
+  if (!json_object || !json_object->is_list())
+    return false;
+
+  for (const auto& rule_set_value : json_object->GetList()) {
+    if (!rule_set_value.is_dict())
+      continue;
+    RuleSet rule_set;
+
+    const base::Value* exclusions = rule_set_value.FindListKey("e");
+    if (exclusions) {
+      for (const auto& exclusion : exclusions->GetList()) {
+        if (!exclusion.is_dict())
+          continue;
+        const std::string* pattern = exclusion.FindStringKey("p");
+        if (!pattern)
+          continue;
+        rule_set.exclusions.push_back(
+            AddPattern(CorrectToRuleToRE2Engine(*pattern)));
+      }
+    }
+
+    const base::Value* rules = rule_set_value.FindListKey("r");
+    if (rules) {
+      rule_set.has_rules = true;
+      for (const auto& rule_value : rules->GetList()) {
+        if (!rule_value.is_dict())
+          continue;
+        Rule rule;
+        if (rule_value.FindKey("d")) {
+          rule.is_default = true;
+          rule_set.rules.push_back(std::move(rule));
+          // Nothing after a default rule is ever reached.
+          break;
+        }
+        const std::string* from = rule_value.FindStringKey("f");
+        const std::string* to = rule_value.FindStringKey("t");
+        if (!from || !to)
+          continue;
+        rule.from = AddPattern(*from);
+        rule.to = CorrectToRuleToRE2Engine(*to);
+        rule_set.rules.push_back(std::move(rule));
+      }
+    }
+
+    entry->push_back(std::move(rule_set));
+    // Rulesets after one without rules are never reached either.
+    if (!entry->back().has_rules)
+      break;
+  }
+  return true;
+}
+
+uint32_t HTTPSEverywhereRuleset::AddPattern(const std::string& pattern) {
+  auto it = pattern_indices_.find(pattern);
+  if (it != pattern_indices_.end())
+    return it->second;
+  uint32_t index = patterns_.size();
+  patterns_.push_back(pattern);
+  pattern_indices_[pattern] = index;
+  return index;
+}
+
+const re2::RE2& HTTPSEverywhereRuleset::GetRegex(uint32_t pattern) const {
+  DCHECK(regexes_);
+  std::atomic<re2::RE2*>& slot = regexes_[pattern];
+  re2::RE2* regex = slot.load(std::memory_order_acquire);
+  if (regex)
+    return *regex;
+
+  auto compiled = std::make_unique<re2::RE2>(patterns_[pattern]);
+  if (slot.compare_exchange_strong(regex, compiled.get(),
+                                   std::memory_order_acq_rel,
+                                   std::memory_order_acquire)) {
+    return *compiled.release();
+  }
+  // Another lookup compiled the same pattern first; |regex| now holds it.
+  // Compiled expressions are never removed, and matching against one is
+  // thread-safe.
+  return *regex;
+}
+
+std::string HTTPSEverywhereRuleset::ApplyEntry(const Entry& entry,
+                                               const std::string& url) const {
+  for (const auto& rule_set : entry) {
+    for (uint32_t exclusion : rule_set.exclusions) {
+      if (re2::RE2::FullMatch(url, GetRegex(exclusion)))
+        return std::string();
+    }
+
+    if (!rule_set.has_rules)
+      return std::string();
+
+    for (const auto& rule : rule_set.rules) {
+      if (rule.is_default) {
+        std::string new_url(url);
+        return new_url.insert(4, "s");
+      }
+      std::string new_url(url);
+      if (re2::RE2::Replace(&new_url, GetRegex(rule.from), rule.to) &&
+          new_url != url) {
+        return new_url;
+      }
+    }
+  }
+  return std::string();
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,122 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+
+namespace re2 {
+class RE2;
+}  // namespace re2
+
+namespace brave_shields {
+
+// An immutable, in-memory form of the HTTPS Everywhere rules database.
+// Hosts are looked up in a trie of reversed labels (com -> foo -> www), and
+// rules are parsed once when the ruleset is built. Identical patterns share
+// one regular expression, compiled without locking the first time it is
+// needed.
+//
+// The ruleset is filled on one sequence with AddEntry() and is read-only,
+// and safe to use from any thread, once it has been shared.
+class HTTPSEverywhereRuleset
+    : public base::RefCountedThreadSafe<HTTPSEverywhereRuleset> {
+ public:
+  HTTPSEverywhereRuleset();
+
+  // Adds the JSON rulesets |value| stored in the database under |key|, a
+  // reversed host such as "com.foo.www" or "com.foo.*". Returns false if
+  // the entry can't be used.
+  bool AddEntry(const std::string& key, const std::string& value);
+
+  // Drops the bookkeeping only needed while entries are added.
+  void FinishBuilding();
+
+  // Returns the HTTPS version of |url|, whose host is |host|, or an empty
+  // string if no rule applies.
+  std::string GetHTTPSURL(const std::string& host,
+                          const std::string& url) const;
+
+  // Returns the ids of the entries which apply to |host|, in the order they
+  // are tried. Empty if no URL on |host| can be upgraded. The ids are only
+  // meaningful to this ruleset.
+  std::vector<uint32_t> GetHostEntries(const std::string& host) const;
+
+  // Returns the HTTPS version of |url| using the entries GetHostEntries()
+  // returned for its host, or an empty string if none applies.
+  std::string ApplyHostEntries(const std::vector<uint32_t>& entry_ids,
+                               const std::string& url) const;
+
+ private:
+  friend class base::RefCountedThreadSafe<HTTPSEverywhereRuleset>;
+  ~HTTPSEverywhereRuleset();
+
+  static const uint32_t kNoEntry = static_cast<uint32_t>(-1);
+
+  struct Rule {
+    // Set for default rules, which only switch the scheme to https.
+    bool is_default = false;
+    uint32_t from = 0;
+    std::string to;
+  };
+
+  struct RuleSet {
+    RuleSet();
+    RuleSet(RuleSet&& other);
+    ~RuleSet();
+
+    std::vector<uint32_t> exclusions;
+    std::vector<Rule> rules;
+    // A ruleset without a rule list stops the lookup for its entry.
+    bool has_rules = false;
+  };
+
+  // All the rulesets stored for one database key.
+  using Entry = std::vector<RuleSet>;
+
+  struct Node {
+    Node();
+    Node(Node&& other);
+    ~Node();
+
+    std::map<std::string, uint32_t> children;
+    uint32_t exact_entry = kNoEntry;
+    uint32_t wildcard_entry = kNoEntry;
+  };
+
+  bool ParseEntry(const std::string& value, Entry* entry);
+  uint32_t AddPattern(const std::string& pattern);
+  const re2::RE2& GetRegex(uint32_t pattern) const;
+  std::string ApplyEntry(const Entry& entry, const std::string& url) const;
+
+  std::vector<Node> nodes_;
+  std::vector<Entry> entries_;
+  std::vector<std::string> patterns_;
+
+  // Build time only: many hosts share the same rulesets and patterns.
+  std::map<std::string, uint32_t> entry_indices_;
+  std::map<std::string, uint32_t> pattern_indices_;
+
+  // One slot per pattern, allocated by FinishBuilding(). Each slot is set
+  // once, by whichever lookup compiles the pattern first, so readers never
+  // take a lock.
+  std::unique_ptr<std::atomic<re2::RE2*>[]> regexes_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSEverywhereRuleset);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
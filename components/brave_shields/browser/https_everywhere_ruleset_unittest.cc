@@ -0,0 +1,82 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <vector>
+
+#include "base/memory/scoped_refptr.h"
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HTTPSEverywhereRuleset;
+
+TEST(HTTPSEverywhereRulesetTest, DefaultRule) {
+  auto ruleset = base::MakeRefCounted<HTTPSEverywhereRuleset>();
+  ASSERT_TRUE(ruleset->AddEntry("com.example", R"([{"r":[{"d":1}]}])"));
+  ruleset->FinishBuilding();
+
+  EXPECT_EQ(ruleset->GetHTTPSURL("example.com", "http://example.com/a"),
+            "https://example.com/a");
+  // Exact entries don't cover subdomains.
+  EXPECT_EQ(ruleset->GetHTTPSURL("www.example.com", "http://www.example.com/"),
+            "");
+  EXPECT_EQ(ruleset->GetHTTPSURL("example.org", "http://example.org/"), "");
+}
+
+TEST(HTTPSEverywhereRulesetTest, WildcardAndExclusions) {
+  auto ruleset = base::MakeRefCounted<HTTPSEverywhereRuleset>();
+  ASSERT_TRUE(ruleset->AddEntry(
+      "com.example.*",
+      R"([{"e":[{"p":"^http://skip\\.example\\.com/.*"}],)"
+      R"("r":[{"f":"^http://([\\w-]+)\\.example\\.com/",)"
+      R"("t":"https://$1.example.com/"}]}])"));
+  // Wildcards on a TLD are never consulted.
+  EXPECT_FALSE(ruleset->AddEntry("com.*", R"([{"r":[{"d":1}]}])"));
+  ruleset->FinishBuilding();
+
+  EXPECT_EQ(ruleset->GetHTTPSURL("www.example.com", "http://www.example.com/"),
+            "https://www.example.com/");
+  EXPECT_EQ(ruleset->GetHTTPSURL("a.b.example.com", "http://a.b.example.com/"),
+            "");
+  EXPECT_EQ(ruleset->GetHTTPSURL("skip.example.com",
+                                 "http://skip.example.com/x"),
+            "");
+  EXPECT_EQ(ruleset->GetHTTPSURL("example.com", "http://example.com/"), "");
+}
+
+TEST(HTTPSEverywhereRulesetTest, ExactHostIsTriedBeforeWildcard) {
+  auto ruleset = base::MakeRefCounted<HTTPSEverywhereRuleset>();
+  ASSERT_TRUE(ruleset->AddEntry(
+      "com.example.*",
+      R"([{"r":[{"f":"^http://cdn\\.","t":"https://static."}]}])"));
+  ASSERT_TRUE(ruleset->AddEntry("com.example.www", R"([{"r":[{"d":1}]}])"));
+  ASSERT_FALSE(ruleset->AddEntry("com.example.bad", "not json"));
+  ruleset->FinishBuilding();
+
+  EXPECT_EQ(ruleset->GetHTTPSURL("www.example.com", "http://www.example.com/"),
+            "https://www.example.com/");
+  EXPECT_EQ(ruleset->GetHTTPSURL("cdn.example.com", "http://cdn.example.com/"),
+            "https://static.example.com/");
+}
+
+TEST(HTTPSEverywhereRulesetTest, HostEntriesApplyToAnyURLOnHost) {
+  auto ruleset = base::MakeRefCounted<HTTPSEverywhereRuleset>();
+  ASSERT_TRUE(ruleset->AddEntry(
+      "com.example.*",
+      R"([{"r":[{"f":"^http://cdn\\.","t":"https://static."}]}])"));
+  ASSERT_TRUE(ruleset->AddEntry("com.example.www", R"([{"r":[{"d":1}]}])"));
+  ruleset->FinishBuilding();
+
+  EXPECT_TRUE(ruleset->GetHostEntries("example.org").empty());
+  EXPECT_EQ(ruleset->GetHostEntries("www.example.com").size(), 2u);
+
+  const std::vector<uint32_t> entry_ids =
+      ruleset->GetHostEntries("cdn.example.com");
+  ASSERT_EQ(entry_ids.size(), 1u);
+  EXPECT_EQ(ruleset->ApplyHostEntries(entry_ids, "http://cdn.example.com/a"),
+            "https://static.example.com/a");
+  EXPECT_EQ(ruleset->ApplyHostEntries(entry_ids, "http://cdn.example.com/b"),
+            "https://static.example.com/b");
+}
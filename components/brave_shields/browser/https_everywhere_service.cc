@@ -12,15 +12,15 @@
 
 #include "base/base_paths.h"
 #include "base/bind.h"
-#include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/scoped_blocking_call.h"
-#include "base/values.h"
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
-#include "third_party/re2/src/re2/re2.h"
+#include "third_party/leveldatabase/src/include/leveldb/iterator.h"
 #include "third_party/zlib/google/zip.h"
 
 #define DAT_FILE "httpse.leveldb.zip"
@@ -30,49 +30,19 @@
 
 namespace {
 
-std::vector<std::string> Split(const std::string& s, char delim) {
-  std::stringstream ss(s);
-  std::string item;
-  std::vector<std::string> result;
-  while (getline(ss, item, delim)) {
-    result.push_back(item);
-  }
-  return result;
-}
-
-// returns parts in reverse order, makes list of lookup domains like com.foo.*
-std::vector<std::string> ExpandDomainForLookup(const std::string& domain) {
-  std::vector<std::string> resultDomains;
-  std::vector<std::string> domainParts = Split(domain, '.');
-  if (domainParts.empty()) {
-    return resultDomains;
-  }
-
-  for (size_t i = 0; i < domainParts.size() - 1; i++) {
-    // i < size()-1 is correct: don't want 'com.*' added to resultDomains
-    std::string slice = "";
-    std::string dot = "";
-    for (int j = domainParts.size() - 1; j >= static_cast<int>(i); j--) {
-      slice += dot + domainParts[j];
-      dot = ".";
-    }
-    if (0 != i) {
-      // We don't want * on the top URL
-      resultDomains.push_back(slice + ".*");
-    } else {
-      resultDomains.push_back(slice);
-    }
-  }
-  return resultDomains;
-}
-std::string leveldbGet(leveldb::DB* db, const std::string &key) {
-  if (!db) {
-    return "";
-  }
-
-  std::string value;
-  leveldb::Status s = db->Get(leveldb::ReadOptions(), key, &value);
-  return s.ok() ? value : "";
+// Note: append-only enumeration! Never remove any existing values, as this
+// enum is used to bucket a UMA histogram, and removing values breaks that.
+enum class HTTPSECacheLookup {
+  kURLHit,  // Obsolete, URLs are no longer cached.
+  kURLNegativeHit,  // Obsolete, URLs are no longer cached.
+  kHostNegativeHit,
+  kMiss,
+  kHostHit,
+  kMaxValue = kHostHit,
+};
+
+void RecordCacheLookup(HTTPSECacheLookup lookup) {
+  UMA_HISTOGRAM_ENUMERATION("Brave.HTTPSE.CacheLookup", lookup);
 }
 
 }  // namespace
@@ -97,10 +67,17 @@ std::string
 HTTPSEverywhereService::g_https_everywhere_component_base64_public_key_(
     kHTTPSEverywhereComponentBase64PublicKey);
 
+HTTPSEverywhereService::HostEntries::HostEntries() = default;
+HTTPSEverywhereService::HostEntries::HostEntries(const HostEntries& other) =
+    default;
+HTTPSEverywhereService::HostEntries::~HostEntries() = default;
+
 HTTPSEverywhereService::HTTPSEverywhereService(
-    BraveComponent::Delegate* delegate)
+    BraveComponent::Delegate* delegate,
+    const CacheParams& cache_params)
     : BaseBraveShieldsService(delegate),
-      level_db_(nullptr) {
+      host_entries_cache_(cache_params.host_count, cache_params.shard_count,
+                          cache_params.negative_ttl) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
@@ -109,10 +86,8 @@ HTTPSEverywhereService::~HTTPSEverywhereService() {
 }
 
 void HTTPSEverywhereService::Cleanup() {
-  GetTaskRunner()->PostTask(
-      FROM_HERE,
-      base::Bind(&HTTPSEverywhereService::CloseDatabase,
-                 AsWeakPtr()));
+  base::AutoLock lock(ruleset_lock_);
+  ruleset_ = nullptr;
 }
 
 bool HTTPSEverywhereService::Init() {
@@ -134,21 +109,45 @@ void HTTPSEverywhereService::InitDB(const base::FilePath& install_dir) {
     return;
   }
 
-  CloseDatabase();
-
+  leveldb::DB* level_db = nullptr;
   leveldb::Options options;
   leveldb::Status status =
       leveldb::DB::Open(options,
                         unzipped_level_db_path.AsUTF8Unsafe(),
-                        &level_db_);
-  if (!status.ok() || !level_db_) {
-    level_db_ = nullptr;
+                        &level_db);
+  if (!status.ok() || !level_db) {
     LOG(ERROR) << "Level db open error "
                << unzipped_level_db_path.value().c_str()
                << ", error: " << status.ToString();
-    CloseDatabase();
+    delete level_db;
     return;
   }
+
+  // Convert the whole database once so that lookups never touch the disk.
+  auto ruleset = base::MakeRefCounted<HTTPSEverywhereRuleset>();
+  std::unique_ptr<leveldb::Iterator> it(
+      level_db->NewIterator(leveldb::ReadOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    ruleset->AddEntry(it->key().ToString(), it->value().ToString());
+  }
+  if (!it->status().ok()) {
+    LOG(ERROR) << "Level db read error "
+               << unzipped_level_db_path.value().c_str()
+               << ", error: " << it->status().ToString();
+  }
+  it.reset();
+  delete level_db;
+  ruleset->FinishBuilding();
+
+  {
+    base::AutoLock lock(ruleset_lock_);
+    ruleset_.swap(ruleset);
+    ruleset_version_++;
+  }
+  // Cached entries of the previous version are ignored anyway. A host seen
+  // without rules by a lookup racing with the update may stay negative until
+  // the entry expires.
+  host_entries_cache_.clear();
 }
 
 void HTTPSEverywhereService::OnComponentReady(
@@ -166,23 +165,19 @@ bool HTTPSEverywhereService::GetHTTPSURL(
     const GURL* url,
     const uint64_t& request_identifier,
     std::string* new_url) {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-
   if (!url->is_valid())
     return false;
 
-  if (!IsInitialized() || !level_db_ || url->scheme() == url::kHttpsScheme) {
+  uint32_t ruleset_version = 0;
+  scoped_refptr<HTTPSEverywhereRuleset> ruleset =
+      GetRuleset(&ruleset_version);
+  if (!IsInitialized() || !ruleset || url->scheme() == url::kHttpsScheme) {
     return false;
   }
   if (!ShouldHTTPSERedirect(request_identifier)) {
     return false;
   }
 
-  if (recently_used_cache_.get(url->spec(), new_url)) {
-    AddHTTPSEUrlToRedirectList(request_identifier);
-    return true;
-  }
-
   GURL candidate_url(*url);
   if (g_ignore_port_for_test_ && candidate_url.has_port()) {
     GURL::Replacements replacements;
@@ -190,42 +185,43 @@ bool HTTPSEverywhereService::GetHTTPSURL(
     candidate_url = candidate_url.ReplaceComponents(replacements);
   }
 
-  const std::vector<std::string> domains =
-      ExpandDomainForLookup(candidate_url.host());
-  for (auto domain : domains) {
-    std::string value = leveldbGet(level_db_, domain);
-    if (!value.empty()) {
-      *new_url = ApplyHTTPSRule(candidate_url.spec(), value);
-      if (0 != new_url->length()) {
-        recently_used_cache_.add(candidate_url.spec(), *new_url);
-        AddHTTPSEUrlToRedirectList(request_identifier);
-        return true;
-      }
+  // Rewrites depend on the whole URL, but which rules apply only depends on
+  // the host, and most hosts have no rule at all.
+  const std::string host = candidate_url.host();
+  using Lookup = HTTPSERecentlyUsedCache<HostEntries>::Lookup;
+  HostEntries host_entries;
+  Lookup lookup = host_entries_cache_.lookup(host, &host_entries);
+  if (lookup == Lookup::kNegativeHit) {
+    RecordCacheLookup(HTTPSECacheLookup::kHostNegativeHit);
+    return false;
+  }
+  if (lookup == Lookup::kHit &&
+      host_entries.ruleset_version == ruleset_version) {
+    RecordCacheLookup(HTTPSECacheLookup::kHostHit);
+  } else {
+    RecordCacheLookup(HTTPSECacheLookup::kMiss);
+    host_entries.ruleset_version = ruleset_version;
+    host_entries.entry_ids = ruleset->GetHostEntries(host);
+    if (host_entries.entry_ids.empty()) {
+      host_entries_cache_.add_negative(host);
+      return false;
     }
+    host_entries_cache_.add(host, host_entries);
   }
-  recently_used_cache_.remove(candidate_url.spec());
-  return false;
-}
 
-bool HTTPSEverywhereService::GetHTTPSURLFromCacheOnly(
-    const GURL* url,
-    const uint64_t& request_identifier,
-    std::string* cached_url) {
-  if (!url->is_valid())
-    return false;
-
-  if (!IsInitialized() || url->scheme() == url::kHttpsScheme) {
-    return false;
-  }
-  if (!ShouldHTTPSERedirect(request_identifier)) {
+  *new_url =
+      ruleset->ApplyHostEntries(host_entries.entry_ids, candidate_url.spec());
+  if (new_url->empty())
     return false;
-  }
+  AddHTTPSEUrlToRedirectList(request_identifier);
+  return true;
+}
 
-  if (recently_used_cache_.get(url->spec(), cached_url)) {
-    AddHTTPSEUrlToRedirectList(request_identifier);
-    return true;
-  }
-  return false;
+scoped_refptr<HTTPSEverywhereRuleset> HTTPSEverywhereService::GetRuleset(
+    uint32_t* version) {
+  base::AutoLock lock(ruleset_lock_);
+  *version = ruleset_version_;
+  return ruleset_;
 }
 
 bool HTTPSEverywhereService::ShouldHTTPSERedirect(
@@ -270,126 +266,6 @@ void HTTPSEverywhereService::AddHTTPSEUrlToRedirectList(
   }
 }
 
-std::string HTTPSEverywhereService::ApplyHTTPSRule(
-    const std::string& originalUrl,
-    const std::string& rule) {
-  base::Optional<base::Value> json_object = base::JSONReader::Read(rule);
-  if (base::nullopt == json_object || !json_object->is_list()) {
-    return "";
-  }
-
-  const base::Value::ListStorage& topValues = json_object->GetList();
-  for (auto it = topValues.cbegin(); it != topValues.cend(); ++it) {
-    if (!it->is_dict()) {
-      continue;
-    }
-    const base::DictionaryValue* childTopDictionary = nullptr;
-    it->GetAsDictionary(&childTopDictionary);
-    if (nullptr == childTopDictionary) {
-      continue;
-    }
-
-    const base::Value* exclusion = nullptr;
-    if (childTopDictionary->Get("e", &exclusion)) {
-      const base::ListValue* eValues = nullptr;
-      exclusion->GetAsList(&eValues);
-      if (nullptr != eValues) {
-        for (size_t j = 0; j < eValues->GetSize(); ++j) {
-          const base::Value* pValue = nullptr;
-          if (!eValues->Get(j, &pValue)) {
-            continue;
-          }
-          const base::DictionaryValue* pDictionary = nullptr;
-          pValue->GetAsDictionary(&pDictionary);
-          if (nullptr == pDictionary) {
-            continue;
-          }
-          const base::Value* patternValue = nullptr;
-          if (!pDictionary->Get("p", &patternValue)) {
-            continue;
-          }
-          std::string pattern;
-          if (!patternValue->GetAsString(&pattern)) {
-            continue;
-          }
-          pattern = CorrecttoRuleToRE2Engine(pattern);
-          if (RE2::FullMatch(originalUrl, pattern)) {
-            return "";
-          }
-        }
-      }
-    }
-
-    const base::Value* rules = nullptr;
-    if (!childTopDictionary->Get("r", &rules)) {
-      return "";
-    }
-    const base::ListValue* rValues = nullptr;
-    rules->GetAsList(&rValues);
-    if (nullptr == rValues) {
-      return "";
-    }
-
-    for (size_t j = 0; j < rValues->GetSize(); ++j) {
-      const base::Value* pValue = nullptr;
-      if (!rValues->Get(j, &pValue)) {
-        continue;
-      }
-      const base::DictionaryValue* pDictionary = nullptr;
-      pValue->GetAsDictionary(&pDictionary);
-      if (nullptr == pDictionary) {
-        continue;
-      }
-      const base::Value* patternValue = nullptr;
-      if (pDictionary->Get("d", &patternValue)) {
-        std::string newUrl(originalUrl);
-        return newUrl.insert(4, "s");
-      }
-
-      const base::Value* from_value = nullptr;
-      const base::Value* to_value = nullptr;
-      if (!pDictionary->Get("f", &from_value) ||
-          !pDictionary->Get("t", &to_value)) {
-        continue;
-      }
-      std::string from, to;
-      if (!from_value->GetAsString(&from) ||
-          !to_value->GetAsString(&to)) {
-        continue;
-      }
-
-      to = CorrecttoRuleToRE2Engine(to);
-      std::string newUrl(originalUrl);
-      RE2 regExp(from);
-
-      if (RE2::Replace(&newUrl, regExp, to) && newUrl != originalUrl) {
-        return newUrl;
-      }
-    }
-  }
-  return "";
-}
-
-std::string HTTPSEverywhereService::CorrecttoRuleToRE2Engine(
-    const std::string& to) {
-  std::string correctedto(to);
-  size_t pos = to.find("$");
-  while (std::string::npos != pos) {
-    correctedto[pos] = '\\';
-    pos = correctedto.find("$");
-  }
-
-  return correctedto;
-}
-
-void HTTPSEverywhereService::CloseDatabase() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  if (level_db_) {
-    delete level_db_;
-    level_db_ = nullptr;
-  }
-}
-
 // static
 void HTTPSEverywhereService::SetComponentIdAndBase64PublicKeyForTest(
     const std::string& component_id,
@@ -408,8 +284,9 @@ void HTTPSEverywhereService::SetIgnorePortForTest(bool ignore) {
 // The brave shields factory. Using the Brave Shields as a singleton
 // is the job of the browser process.
 std::unique_ptr<HTTPSEverywhereService> HTTPSEverywhereServiceFactory(
-    BraveComponent::Delegate* delegate) {
-  return std::make_unique<HTTPSEverywhereService>(delegate);
+    BraveComponent::Delegate* delegate,
+    const HTTPSEverywhereService::CacheParams& cache_params) {
+  return std::make_unique<HTTPSEverywhereService>(delegate, cache_params);
 }
 
 }  // namespace brave_shields
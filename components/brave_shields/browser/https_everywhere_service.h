@@ -11,22 +11,22 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/synchronization/lock.h"
+#include "base/time/time.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
 
-namespace leveldb {
-class DB;
-}
-
 class HTTPSEverywhereServiceTest;
 
 using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
 
+class HTTPSEverywhereRuleset;
+
 extern const char kHTTPSEverywhereComponentName[];
 extern const char kHTTPSEverywhereComponentId[];
 extern const char kHTTPSEverywhereComponentBase64PublicKey[];
@@ -46,14 +46,21 @@ struct HTTPSE_REDIRECTS_COUNT_ST {
 class HTTPSEverywhereService : public BaseBraveShieldsService,
                          public base::SupportsWeakPtr<HTTPSEverywhereService> {
  public:
-  explicit HTTPSEverywhereService(BraveComponent::Delegate* delegate);
+  // Limits of the cache of the rules found for each host.
+  struct CacheParams {
+    size_t host_count = 2000;
+    size_t shard_count = 8;
+    // How long a host is remembered to have no rule.
+    base::TimeDelta negative_ttl = base::TimeDelta::FromMinutes(30);
+  };
+
+  HTTPSEverywhereService(BraveComponent::Delegate* delegate,
+                         const CacheParams& cache_params);
   ~HTTPSEverywhereService() override;
+  // Safe to call from any thread; lookups are served from memory.
   bool GetHTTPSURL(const GURL* url,
                    const uint64_t& request_id,
                    std::string* new_url);
-  bool GetHTTPSURLFromCacheOnly(const GURL* url,
-                                const uint64_t& request_id,
-                                std::string* cached_url);
 
  protected:
   bool Init() override;
@@ -64,9 +71,6 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
 
   void AddHTTPSEUrlToRedirectList(const uint64_t& request_id);
   bool ShouldHTTPSERedirect(const uint64_t& request_id);
-  std::string ApplyHTTPSRule(const std::string& originalUrl,
-      const std::string& rule);
-  std::string CorrecttoRuleToRE2Engine(const std::string& to);
 
  private:
   friend class ::HTTPSEverywhereServiceTest;
@@ -78,14 +82,29 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
       const std::string& component_id,
       const std::string& component_base64_public_key);
 
-  void CloseDatabase();
+  // The ids of the ruleset entries for a host, and the version of the
+  // ruleset they belong to.
+  struct HostEntries {
+    HostEntries();
+    HostEntries(const HostEntries& other);
+    ~HostEntries();
+
+    uint32_t ruleset_version = 0;
+    std::vector<uint32_t> entry_ids;
+  };
 
   void InitDB(const base::FilePath& install_dir);
+  scoped_refptr<HTTPSEverywhereRuleset> GetRuleset(uint32_t* version);
 
   base::Lock httpse_get_urls_redirects_count_mutex_;
   std::vector<HTTPSE_REDIRECTS_COUNT_ST> httpse_urls_redirects_count_;
-  HTTPSERecentlyUsedCache<std::string> recently_used_cache_;
-  leveldb::DB* level_db_;
+  // The entries which apply to each host, keyed by host. Hosts without any
+  // rule are negative entries.
+  HTTPSERecentlyUsedCache<HostEntries> host_entries_cache_;
+  // Built from the database on the task runner, then only read.
+  base::Lock ruleset_lock_;
+  scoped_refptr<HTTPSEverywhereRuleset> ruleset_;
+  uint32_t ruleset_version_ = 0;
 
   SEQUENCE_CHECKER(sequence_checker_);
   DISALLOW_COPY_AND_ASSIGN(HTTPSEverywhereService);
@@ -93,7 +112,9 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
 
 // Creates the HTTPSEverywhereService
 std::unique_ptr<HTTPSEverywhereService> HTTPSEverywhereServiceFactory(
-    BraveComponent::Delegate* delegate);
+    BraveComponent::Delegate* delegate,
+    const HTTPSEverywhereService::CacheParams& cache_params =
+        HTTPSEverywhereService::CacheParams());
 
 }  // namespace brave_shields
 
@@ -0,0 +1,75 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_PROFILE_CONTENT_SETTINGS_DATA_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_PROFILE_CONTENT_SETTINGS_DATA_H_
+
+#include <memory>
+#include <utility>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/supports_user_data.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/profiles/profile.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+
+namespace brave_shields {
+
+// Data derived from the content settings of a profile, attached to the
+// profile on first use. Subclasses implement
+// content_settings::Observer::OnContentSettingChanged to drop what the change
+// makes stale, and are constructed from the Profile they belong to:
+//
+//   class FooData : public ProfileContentSettingsData<FooData> {
+//    public:
+//     explicit FooData(Profile* profile)
+//         : ProfileContentSettingsData<FooData>(profile) {}
+//     ...
+//   };
+//
+//   FooData::FromProfile(profile)->...
+template <typename T>
+class ProfileContentSettingsData : public base::SupportsUserData::Data,
+                                   public content_settings::Observer {
+ public:
+  ~ProfileContentSettingsData() override { map_->RemoveObserver(this); }
+
+  static T* FromProfile(Profile* profile) {
+    auto* data = static_cast<T*>(profile->GetUserData(UserDataKey()));
+    if (!data) {
+      auto new_data = std::make_unique<T>(profile);
+      data = new_data.get();
+      profile->SetUserData(UserDataKey(), std::move(new_data));
+    }
+    return data;
+  }
+
+ protected:
+  explicit ProfileContentSettingsData(Profile* profile)
+      : profile_(profile),
+        map_(HostContentSettingsMapFactory::GetForProfile(profile)) {
+    map_->AddObserver(this);
+  }
+
+  Profile* profile() const { return profile_; }
+  HostContentSettingsMap* map() const { return map_.get(); }
+
+ private:
+  static const void* UserDataKey() {
+    static const int kUserDataKey = 0;
+    return &kUserDataKey;
+  }
+
+  Profile* profile_;  // Not owned
+  scoped_refptr<HostContentSettingsMap> map_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProfileContentSettingsData);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_PROFILE_CONTENT_SETTINGS_DATA_H_
@@ -33,41 +33,28 @@ ReferrerWhitelistService::ReferrerWhitelistService(
 ReferrerWhitelistService::~ReferrerWhitelistService() {
 }
 
-ReferrerWhitelistService::ReferrerWhitelist::ReferrerWhitelist() = default;
-ReferrerWhitelistService::ReferrerWhitelist::ReferrerWhitelist(
-  const ReferrerWhitelist& other) = default;
-ReferrerWhitelistService::ReferrerWhitelist::~ReferrerWhitelist() = default;
-
 bool ReferrerWhitelistService::IsWhitelisted(
     const GURL& first_party_origin, const GURL& subresource_url) const {
   if (BrowserThread::CurrentlyOn(BrowserThread::IO)) {
-    return IsWhitelisted(
-        referrer_whitelist_io_thread_, first_party_origin, subresource_url);
+    return IsWhitelisted(referrer_whitelist_io_thread_.get(),
+                         first_party_origin, subresource_url);
   } else {
-    return IsWhitelisted(
-        referrer_whitelist_, first_party_origin, subresource_url);
+    return IsWhitelisted(referrer_whitelist_.get(), first_party_origin,
+                         subresource_url);
   }
 }
 
 bool ReferrerWhitelistService::IsWhitelisted(
-    const std::vector<ReferrerWhitelist>& whitelist,
+    const ReferrerWhitelist* whitelist,
     const GURL& first_party_origin,
     const GURL& subresource_url) const {
-  for (auto rw : whitelist) {
-    if (rw.first_party_pattern.MatchesURL(first_party_origin)) {
-      for (auto subresource_pattern : rw.subresource_pattern_list) {
-        if (subresource_pattern.MatchesURL(subresource_url)) {
-          return true;
-        }
-      }
-    }
-  }
-  return false;
+  return whitelist &&
+         whitelist->data.MatchesAny(first_party_origin, subresource_url);
 }
 
 void ReferrerWhitelistService::OnDATFileDataReady(std::string contents) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  referrer_whitelist_.clear();
+  referrer_whitelist_ = nullptr;
   if (contents.empty()) {
     LOG(ERROR) << "Could not obtain referrer whitelist data";
     return;
@@ -82,22 +69,24 @@ void ReferrerWhitelistService::OnDATFileDataReady(std::string contents) {
   root->GetAsDictionary(&root_dict);
   base::ListValue* whitelist = nullptr;
   root_dict->GetList("whitelist", &whitelist);
+  brave::SubresourceURLPatternMatcher matcher;
   for (base::Value& origins : whitelist->GetList()) {
     base::DictionaryValue* origins_dict = nullptr;
     origins.GetAsDictionary(&origins_dict);
     for (const auto& it : origins_dict->DictItems()) {
-      ReferrerWhitelist rw;
-      rw.first_party_pattern = URLPattern(
-        URLPattern::SCHEME_HTTP|URLPattern::SCHEME_HTTPS, it.first);
-      URLPatternList subresource_pattern_list;
+      std::vector<URLPattern> subresource_patterns;
       for (base::Value& subresource_value : it.second.GetList()) {
-        rw.subresource_pattern_list.push_back(URLPattern(
+        subresource_patterns.push_back(URLPattern(
           URLPattern::SCHEME_HTTP|URLPattern::SCHEME_HTTPS,
           subresource_value.GetString()));
       }
-      referrer_whitelist_.push_back(rw);
+      matcher.Add(URLPattern(
+          URLPattern::SCHEME_HTTP|URLPattern::SCHEME_HTTPS, it.first),
+          subresource_patterns);
     }
   }
+  referrer_whitelist_ =
+      base::MakeRefCounted<ReferrerWhitelist>(std::move(matcher));
 
   base::PostTask(
       FROM_HERE, {BrowserThread::IO},
@@ -107,7 +96,7 @@ void ReferrerWhitelistService::OnDATFileDataReady(std::string contents) {
 }
 
 void ReferrerWhitelistService::OnDATFileDataReadyOnIOThread(
-    std::vector<ReferrerWhitelist> whitelist) {
+    scoped_refptr<const ReferrerWhitelist> whitelist) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   referrer_whitelist_io_thread_ = std::move(whitelist);
 }
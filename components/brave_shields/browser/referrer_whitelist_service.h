@@ -11,10 +11,11 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
+#include "brave/common/url_pattern_matcher.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
-#include "extensions/common/url_pattern.h"
 #include "url/gurl.h"
 
 #define REFERRER_DAT_FILE "ReferrerWhitelist.json"
@@ -45,24 +46,20 @@ class ReferrerWhitelistService : public LocalDataFilesObserver {
  private:
   friend class ::ReferrerWhitelistServiceTest;
 
-  struct ReferrerWhitelist {
-    URLPattern first_party_pattern;
-    URLPatternList subresource_pattern_list;
-    ReferrerWhitelist();
-    ReferrerWhitelist(const ReferrerWhitelist& other);
-    ~ReferrerWhitelist();
-  };
+  // The whitelist is compiled once per DAT file update and then shared by the
+  // UI and IO threads, as it is never modified.
+  using ReferrerWhitelist =
+      base::RefCountedData<brave::SubresourceURLPatternMatcher>;
 
-  bool IsWhitelisted(const std::vector<ReferrerWhitelist>& whitelist,
+  bool IsWhitelisted(const ReferrerWhitelist* whitelist,
                      const GURL& first_party_origin,
                      const GURL& subresource_url) const;
   void OnDATFileDataReady(std::string contents);
-  void OnDATFileDataReadyOnIOThread(std::vector<ReferrerWhitelist> whitelist);
+  void OnDATFileDataReadyOnIOThread(
+      scoped_refptr<const ReferrerWhitelist> whitelist);
 
-  typedef std::vector<URLPattern> URLPatternList;
-
-  std::vector<ReferrerWhitelist> referrer_whitelist_;
-  std::vector<ReferrerWhitelist> referrer_whitelist_io_thread_;
+  scoped_refptr<const ReferrerWhitelist> referrer_whitelist_;
+  scoped_refptr<const ReferrerWhitelist> referrer_whitelist_io_thread_;
 
   SEQUENCE_CHECKER(sequence_checker_);
   base::WeakPtrFactory<ReferrerWhitelistService> weak_factory_;
@@ -0,0 +1,72 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/renderer_content_setting_rules_sender.h"
+
+#include "chrome/common/renderer_configuration.mojom.h"
+#include "components/content_settings/core/common/content_settings_utils.h"
+#include "content/public/browser/child_process_termination_info.h"
+#include "ipc/ipc_channel_proxy.h"
+
+namespace brave_shields {
+
+RendererContentSettingRulesSender::RendererContentSettingRulesSender(
+    Profile* profile)
+    : ProfileContentSettingsData<RendererContentSettingRulesSender>(profile),
+      processes_with_current_rules_(this) {}
+
+RendererContentSettingRulesSender::~RendererContentSettingRulesSender() =
+    default;
+
+void RendererContentSettingRulesSender::MaybeSendTo(
+    content::RenderProcessHost* process) {
+  if (processes_with_current_rules_.IsObserving(process))
+    return;
+
+  if (!rules_) {
+    rules_ = std::make_unique<RendererContentSettingRules>();
+    GetRendererContentSettingRules(map(), rules_.get());
+  }
+  if (SendRules(process, *rules_))
+    processes_with_current_rules_.Add(process);
+}
+
+bool RendererContentSettingRulesSender::SendRules(
+    content::RenderProcessHost* process,
+    const RendererContentSettingRules& rules) {
+  IPC::ChannelProxy* channel = process->GetChannel();
+  // channel might be NULL in tests.
+  if (!channel)
+    return false;
+
+  chrome::mojom::RendererConfigurationAssociatedPtr rc_interface;
+  channel->GetRemoteAssociatedInterface(&rc_interface);
+  rc_interface->SetContentSettingRules(rules);
+  return true;
+}
+
+void RendererContentSettingRulesSender::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type,
+    const std::string& resource_identifier) {
+  rules_.reset();
+  processes_with_current_rules_.RemoveAll();
+}
+
+void RendererContentSettingRulesSender::RenderProcessExited(
+    content::RenderProcessHost* host,
+    const content::ChildProcessTerminationInfo& info) {
+  // The host keeps its id when it relaunches a renderer, and the new renderer
+  // starts without any rules.
+  processes_with_current_rules_.Remove(host);
+}
+
+void RendererContentSettingRulesSender::RenderProcessHostDestroyed(
+    content::RenderProcessHost* host) {
+  processes_with_current_rules_.Remove(host);
+}
+
+}  // namespace brave_shields
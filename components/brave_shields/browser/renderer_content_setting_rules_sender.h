@@ -0,0 +1,66 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_RENDERER_CONTENT_SETTING_RULES_SENDER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_RENDERER_CONTENT_SETTING_RULES_SENDER_H_
+
+#include <memory>
+#include <string>
+
+#include "base/macros.h"
+#include "base/scoped_observer.h"
+#include "brave/components/brave_shields/browser/profile_content_settings_data.h"
+#include "components/content_settings/core/common/content_settings.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/render_process_host_observer.h"
+
+namespace brave_shields {
+
+// Sends the content setting rules of a profile to its renderers. The rules
+// are computed once per change of the profile's content settings, and sent
+// once to each render process since all the frames of a process share them.
+// A render process which exits gets the rules again once it is relaunched.
+class RendererContentSettingRulesSender
+    : public ProfileContentSettingsData<RendererContentSettingRulesSender>,
+      public content::RenderProcessHostObserver {
+ public:
+  explicit RendererContentSettingRulesSender(Profile* profile);
+  ~RendererContentSettingRulesSender() override;
+
+  // Sends the current rules to |process| unless it already has them.
+  void MaybeSendTo(content::RenderProcessHost* process);
+
+  // content_settings::Observer:
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type,
+                               const std::string& resource_identifier)
+      override;
+
+  // content::RenderProcessHostObserver:
+  void RenderProcessExited(
+      content::RenderProcessHost* host,
+      const content::ChildProcessTerminationInfo& info) override;
+  void RenderProcessHostDestroyed(content::RenderProcessHost* host) override;
+
+ protected:
+  // Returns false if |process| cannot be sent anything yet.
+  virtual bool SendRules(content::RenderProcessHost* process,
+                         const RendererContentSettingRules& rules);
+
+ private:
+  // Computed on the first send after a change.
+  std::unique_ptr<RendererContentSettingRules> rules_;
+  // The render processes which have been sent |rules_|. Processes are only
+  // observed while they are.
+  ScopedObserver<content::RenderProcessHost, content::RenderProcessHostObserver>
+      processes_with_current_rules_;
+
+  DISALLOW_COPY_AND_ASSIGN(RendererContentSettingRulesSender);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_RENDERER_CONTENT_SETTING_RULES_SENDER_H_
@@ -0,0 +1,121 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/renderer_content_setting_rules_sender.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/prefs/browser_prefs.h"
+#include "chrome/test/base/testing_profile.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "components/sync_preferences/testing_pref_service_syncable.h"
+#include "content/public/test/mock_render_process_host.h"
+#include "content/public/test/test_renderer_host.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave_shields::RendererContentSettingRulesSender;
+
+namespace {
+
+class TestRendererContentSettingRulesSender
+    : public RendererContentSettingRulesSender {
+ public:
+  explicit TestRendererContentSettingRulesSender(Profile* profile)
+      : RendererContentSettingRulesSender(profile) {}
+
+  int sent_count() const { return sent_count_; }
+
+ protected:
+  bool SendRules(content::RenderProcessHost* process,
+                 const RendererContentSettingRules& rules) override {
+    ++sent_count_;
+    return true;
+  }
+
+ private:
+  int sent_count_ = 0;
+};
+
+}  // namespace
+
+class RendererContentSettingRulesSenderTest
+    : public content::RenderViewHostTestHarness {
+ protected:
+  void SetUp() override {
+    content::RenderViewHostTestHarness::SetUp();
+    sender_ = std::make_unique<TestRendererContentSettingRulesSender>(
+        profile());
+  }
+
+  void TearDown() override {
+    sender_.reset();
+    content::RenderViewHostTestHarness::TearDown();
+  }
+
+  std::unique_ptr<content::BrowserContext> CreateBrowserContext() override {
+    TestingProfile::Builder builder;
+    auto prefs =
+        std::make_unique<sync_preferences::TestingPrefServiceSyncable>();
+    RegisterUserProfilePrefs(prefs->registry());
+    builder.SetPrefService(std::move(prefs));
+    return builder.Build();
+  }
+
+  Profile* profile() { return static_cast<Profile*>(browser_context()); }
+
+  TestRendererContentSettingRulesSender* sender() { return sender_.get(); }
+
+ private:
+  std::unique_ptr<TestRendererContentSettingRulesSender> sender_;
+};
+
+TEST_F(RendererContentSettingRulesSenderTest, SendsOncePerProcess) {
+  sender()->MaybeSendTo(process());
+  sender()->MaybeSendTo(process());
+  EXPECT_EQ(1, sender()->sent_count());
+
+  content::MockRenderProcessHost other_process(browser_context());
+  sender()->MaybeSendTo(&other_process);
+  sender()->MaybeSendTo(process());
+  EXPECT_EQ(2, sender()->sent_count());
+}
+
+TEST_F(RendererContentSettingRulesSenderTest, ResendsAfterRelaunch) {
+  sender()->MaybeSendTo(process());
+  EXPECT_EQ(1, sender()->sent_count());
+
+  // The relaunched renderer keeps the id of the crashed one.
+  process()->SimulateCrash();
+  sender()->MaybeSendTo(process());
+  EXPECT_EQ(2, sender()->sent_count());
+}
+
+TEST_F(RendererContentSettingRulesSenderTest, ForgetsDestroyedProcesses) {
+  {
+    content::MockRenderProcessHost other_process(browser_context());
+    sender()->MaybeSendTo(&other_process);
+    EXPECT_EQ(1, sender()->sent_count());
+  }
+
+  sender()->MaybeSendTo(process());
+  EXPECT_EQ(2, sender()->sent_count());
+}
+
+TEST_F(RendererContentSettingRulesSenderTest, ResendsAfterSettingChange) {
+  sender()->MaybeSendTo(process());
+  EXPECT_EQ(1, sender()->sent_count());
+
+  HostContentSettingsMapFactory::GetForProfile(profile())
+      ->SetContentSettingDefaultScope(GURL("https://brave.com/"), GURL(),
+                                      ContentSettingsType::JAVASCRIPT,
+                                      std::string(), CONTENT_SETTING_BLOCK);
+  sender()->MaybeSendTo(process());
+  sender()->MaybeSendTo(process());
+  EXPECT_EQ(2, sender()->sent_count());
+}
@@ -0,0 +1,76 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_settings_snapshot.h"
+
+#include <map>
+#include <string>
+
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/browser/profile_content_settings_data.h"
+#include "content/public/browser/browser_thread.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Pages rarely come from more origins than this between two changes of the
+// content settings, the snapshots are resolved again if they do.
+const size_t kMaxSnapshots = 256;
+
+// The snapshots of a profile, keyed by tab origin. Shields settings are all
+// stored as PLUGINS content settings, so the snapshots are dropped when any
+// of those changes.
+class ShieldsSettingsSnapshots
+    : public ProfileContentSettingsData<ShieldsSettingsSnapshots> {
+ public:
+  explicit ShieldsSettingsSnapshots(Profile* profile)
+      : ProfileContentSettingsData<ShieldsSettingsSnapshots>(profile) {}
+
+  const ShieldsSettingsSnapshot& Get(const GURL& tab_origin) {
+    auto it = snapshots_.find(tab_origin);
+    if (it != snapshots_.end())
+      return it->second;
+
+    if (snapshots_.size() >= kMaxSnapshots)
+      snapshots_.clear();
+
+    ShieldsSettingsSnapshot snapshot;
+    snapshot.brave_shields_enabled = GetBraveShieldsEnabled(map(), tab_origin);
+    snapshot.allow_ads =
+        GetAdControlType(profile(), tab_origin) == ControlType::ALLOW;
+    snapshot.https_everywhere_enabled =
+        GetHTTPSEverywhereEnabled(profile(), tab_origin);
+    snapshot.allow_referrers = AllowReferrers(map(), tab_origin);
+    return snapshots_.emplace(tab_origin, snapshot).first->second;
+  }
+
+  // content_settings::Observer:
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type,
+                               const std::string& resource_identifier)
+      override {
+    if (content_type == ContentSettingsType::PLUGINS)
+      snapshots_.clear();
+  }
+
+ private:
+  std::map<GURL, ShieldsSettingsSnapshot> snapshots_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsSettingsSnapshots);
+};
+
+}  // namespace
+
+const ShieldsSettingsSnapshot& GetShieldsSettingsSnapshot(
+    Profile* profile,
+    const GURL& tab_origin) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  return ShieldsSettingsSnapshots::FromProfile(profile)->Get(tab_origin);
+}
+
+}  // namespace brave_shields
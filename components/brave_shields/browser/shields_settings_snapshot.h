@@ -0,0 +1,31 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_SNAPSHOT_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_SNAPSHOT_H_
+
+class GURL;
+class Profile;
+
+namespace brave_shields {
+
+// The shields settings which apply to every request of a page.
+struct ShieldsSettingsSnapshot {
+  bool brave_shields_enabled = true;
+  bool allow_ads = false;
+  bool https_everywhere_enabled = true;
+  bool allow_referrers = false;
+};
+
+// Returns the shields settings of pages from |tab_origin| in |profile|. They
+// are resolved once per origin and kept until the content settings of
+// |profile| change. Must be called on the UI thread.
+const ShieldsSettingsSnapshot& GetShieldsSettingsSnapshot(
+    Profile* profile,
+    const GURL& tab_origin);
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_SNAPSHOT_H_
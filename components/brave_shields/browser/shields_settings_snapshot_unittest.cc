@@ -0,0 +1,72 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_settings_snapshot.h"
+
+#include <memory>
+
+#include "base/macros.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/test/base/testing_profile.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave_shields::ControlType;
+using brave_shields::GetShieldsSettingsSnapshot;
+
+class ShieldsSettingsSnapshotTest : public testing::Test {
+ public:
+  ShieldsSettingsSnapshotTest() = default;
+  ~ShieldsSettingsSnapshotTest() override = default;
+
+  void SetUp() override { profile_ = std::make_unique<TestingProfile>(); }
+
+  TestingProfile* profile() { return profile_.get(); }
+
+ private:
+  content::BrowserTaskEnvironment task_environment_;
+  std::unique_ptr<TestingProfile> profile_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsSettingsSnapshotTest);
+};
+
+TEST_F(ShieldsSettingsSnapshotTest, ResolvedFromContentSettings) {
+  const GURL url("https://brave.com");
+  brave_shields::SetAdControlType(profile(), ControlType::ALLOW, url);
+
+  const auto& snapshot = GetShieldsSettingsSnapshot(profile(), url);
+  EXPECT_TRUE(snapshot.brave_shields_enabled);
+  EXPECT_TRUE(snapshot.allow_ads);
+
+  // Other origins keep the defaults.
+  const auto& other_snapshot =
+      GetShieldsSettingsSnapshot(profile(), GURL("https://example.com"));
+  EXPECT_TRUE(other_snapshot.brave_shields_enabled);
+  EXPECT_FALSE(other_snapshot.allow_ads);
+}
+
+TEST_F(ShieldsSettingsSnapshotTest, DroppedWhenShieldsSettingsChange) {
+  const GURL url("https://brave.com");
+  const GURL other_url("https://example.com");
+  EXPECT_TRUE(
+      GetShieldsSettingsSnapshot(profile(), url).brave_shields_enabled);
+  EXPECT_FALSE(GetShieldsSettingsSnapshot(profile(), other_url).allow_ads);
+
+  // Both snapshots are cached now. A PLUGINS content setting change for one
+  // origin drops all of them.
+  brave_shields::SetBraveShieldsEnabled(profile(), false, url);
+  EXPECT_FALSE(
+      GetShieldsSettingsSnapshot(profile(), url).brave_shields_enabled);
+
+  brave_shields::SetAdControlType(profile(), ControlType::ALLOW, other_url);
+  EXPECT_TRUE(GetShieldsSettingsSnapshot(profile(), other_url).allow_ads);
+  EXPECT_FALSE(
+      GetShieldsSettingsSnapshot(profile(), url).brave_shields_enabled);
+
+  brave_shields::SetBraveShieldsEnabled(profile(), true, url);
+  EXPECT_TRUE(
+      GetShieldsSettingsSnapshot(profile(), url).brave_shields_enabled);
+}
@@ -0,0 +1,172 @@
+/* Copyright 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_sync/bookmark_object_id_index.h"
+
+#include "base/no_destructor.h"
+#include "components/bookmarks/browser/bookmark_model.h"
+#include "ui/base/models/tree_node_iterator.h"
+
+namespace brave_sync {
+
+namespace {
+
+// There is an index per syncing profile at most, so they are few enough to
+// all be told about assigned object ids.
+std::unordered_set<BookmarkObjectIdIndex*>& GetIndexes() {
+  static base::NoDestructor<std::unordered_set<BookmarkObjectIdIndex*>>
+      indexes;
+  return *indexes;
+}
+
+}  // namespace
+
+BookmarkObjectIdIndex::BookmarkObjectIdIndex(bookmarks::BookmarkModel* model)
+    : model_(model) {
+  DCHECK(model_);
+  model_->AddObserver(this);
+  GetIndexes().insert(this);
+  if (model_->loaded())
+    Rebuild();
+}
+
+BookmarkObjectIdIndex::~BookmarkObjectIdIndex() {
+  GetIndexes().erase(this);
+  model_->RemoveObserver(this);
+}
+
+const bookmarks::BookmarkNode* BookmarkObjectIdIndex::Find(
+    const std::string& object_id) {
+  if (object_id.empty())
+    return nullptr;
+
+  return Lookup(object_id);
+}
+
+void BookmarkObjectIdIndex::Update(const bookmarks::BookmarkNode* node) {
+  RemoveNode(node);
+  AddNode(node);
+}
+
+// static
+void BookmarkObjectIdIndex::OnObjectIdAssigned(
+    const bookmarks::BookmarkNode* node) {
+  for (BookmarkObjectIdIndex* index : GetIndexes()) {
+    if (index->nodes_without_object_id_.count(node))
+      index->Update(node);
+  }
+}
+
+void BookmarkObjectIdIndex::BookmarkModelLoaded(
+    bookmarks::BookmarkModel* model,
+    bool ids_reassigned) {
+  Rebuild();
+}
+
+void BookmarkObjectIdIndex::BookmarkNodeAdded(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* parent,
+    size_t index) {
+  AddSubtree(parent->children()[index].get());
+}
+
+void BookmarkObjectIdIndex::BookmarkNodeRemoved(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* parent,
+    size_t old_index,
+    const bookmarks::BookmarkNode* node,
+    const std::set<GURL>& no_longer_bookmarked) {
+  RemoveSubtree(node);
+}
+
+void BookmarkObjectIdIndex::OnWillChangeBookmarkMetaInfo(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* node) {
+  RemoveNode(node);
+}
+
+void BookmarkObjectIdIndex::BookmarkMetaInfoChanged(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* node) {
+  Update(node);
+}
+
+void BookmarkObjectIdIndex::BookmarkAllUserNodesRemoved(
+    bookmarks::BookmarkModel* model,
+    const std::set<GURL>& removed_urls) {
+  Rebuild();
+}
+
+void BookmarkObjectIdIndex::Rebuild() {
+  nodes_by_object_id_.clear();
+  object_ids_by_node_.clear();
+  nodes_without_object_id_.clear();
+
+  // The root node is never synced
+  ui::TreeNodeIterator<const bookmarks::BookmarkNode> iterator(
+      model_->root_node());
+  while (iterator.has_next())
+    AddNode(iterator.Next());
+}
+
+void BookmarkObjectIdIndex::AddSubtree(const bookmarks::BookmarkNode* node) {
+  AddNode(node);
+  ui::TreeNodeIterator<const bookmarks::BookmarkNode> iterator(node);
+  while (iterator.has_next())
+    AddNode(iterator.Next());
+}
+
+void BookmarkObjectIdIndex::RemoveSubtree(
+    const bookmarks::BookmarkNode* node) {
+  RemoveNode(node);
+  ui::TreeNodeIterator<const bookmarks::BookmarkNode> iterator(node);
+  while (iterator.has_next())
+    RemoveNode(iterator.Next());
+}
+
+void BookmarkObjectIdIndex::AddNode(const bookmarks::BookmarkNode* node) {
+  std::string object_id;
+  node->GetMetaInfo("object_id", &object_id);
+  if (object_id.empty()) {
+    nodes_without_object_id_.insert(node);
+    return;
+  }
+
+  nodes_by_object_id_[object_id] = node;
+  object_ids_by_node_[node] = object_id;
+}
+
+void BookmarkObjectIdIndex::RemoveNode(const bookmarks::BookmarkNode* node) {
+  nodes_without_object_id_.erase(node);
+
+  auto it = object_ids_by_node_.find(node);
+  if (it == object_ids_by_node_.end())
+    return;
+
+  auto node_it = nodes_by_object_id_.find(it->second);
+  if (node_it != nodes_by_object_id_.end() && node_it->second == node)
+    nodes_by_object_id_.erase(node_it);
+  object_ids_by_node_.erase(it);
+}
+
+const bookmarks::BookmarkNode* BookmarkObjectIdIndex::Lookup(
+    const std::string& object_id) {
+  auto it = nodes_by_object_id_.find(object_id);
+  if (it == nodes_by_object_id_.end())
+    return nullptr;
+
+  // Object ids can still be changed without notifying the model observers, in
+  // which case the node is indexed again under its current object id
+  const bookmarks::BookmarkNode* node = it->second;
+  std::string node_object_id;
+  node->GetMetaInfo("object_id", &node_object_id);
+  if (node_object_id == object_id)
+    return node;
+
+  Update(node);
+  return nullptr;
+}
+
+}  // namespace brave_sync
@@ -0,0 +1,98 @@
+/* Copyright 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SYNC_BOOKMARK_OBJECT_ID_INDEX_H_
+#define BRAVE_COMPONENTS_BRAVE_SYNC_BOOKMARK_OBJECT_ID_INDEX_H_
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "base/macros.h"
+#include "components/bookmarks/browser/bookmark_model_observer.h"
+
+namespace bookmarks {
+class BookmarkModel;
+class BookmarkNode;
+}  // namespace bookmarks
+
+namespace brave_sync {
+
+// Maps the "object_id" meta info of bookmark nodes to the nodes, kept current
+// through BookmarkModelObserver.
+// Object ids of new nodes are assigned by AddBraveMetaInfo without notifying
+// the model observers, so it calls OnObjectIdAssigned instead. Other callers
+// which set the object id of an indexed node without notifying the model
+// observers must call Update.
+class BookmarkObjectIdIndex : public bookmarks::BookmarkModelObserver {
+ public:
+  explicit BookmarkObjectIdIndex(bookmarks::BookmarkModel* model);
+  ~BookmarkObjectIdIndex() override;
+
+  const bookmarks::BookmarkNode* Find(const std::string& object_id);
+
+  void Update(const bookmarks::BookmarkNode* node);
+
+  // Indexes |node| under the object id just assigned to it in every index
+  // which knew it without one.
+  static void OnObjectIdAssigned(const bookmarks::BookmarkNode* node);
+
+  // bookmarks::BookmarkModelObserver implementation
+  void BookmarkModelLoaded(bookmarks::BookmarkModel* model,
+                           bool ids_reassigned) override;
+  void BookmarkNodeMoved(bookmarks::BookmarkModel* model,
+                         const bookmarks::BookmarkNode* old_parent,
+                         size_t old_index,
+                         const bookmarks::BookmarkNode* new_parent,
+                         size_t new_index) override {}
+  void BookmarkNodeAdded(bookmarks::BookmarkModel* model,
+                         const bookmarks::BookmarkNode* parent,
+                         size_t index) override;
+  void BookmarkNodeRemoved(
+      bookmarks::BookmarkModel* model,
+      const bookmarks::BookmarkNode* parent,
+      size_t old_index,
+      const bookmarks::BookmarkNode* node,
+      const std::set<GURL>& no_longer_bookmarked) override;
+  void BookmarkNodeChanged(bookmarks::BookmarkModel* model,
+                           const bookmarks::BookmarkNode* node) override {}
+  void OnWillChangeBookmarkMetaInfo(
+      bookmarks::BookmarkModel* model,
+      const bookmarks::BookmarkNode* node) override;
+  void BookmarkMetaInfoChanged(bookmarks::BookmarkModel* model,
+                               const bookmarks::BookmarkNode* node) override;
+  void BookmarkNodeFaviconChanged(
+      bookmarks::BookmarkModel* model,
+      const bookmarks::BookmarkNode* node) override {}
+  void BookmarkNodeChildrenReordered(
+      bookmarks::BookmarkModel* model,
+      const bookmarks::BookmarkNode* node) override {}
+  void BookmarkAllUserNodesRemoved(
+      bookmarks::BookmarkModel* model,
+      const std::set<GURL>& removed_urls) override;
+
+ private:
+  void Rebuild();
+  void AddSubtree(const bookmarks::BookmarkNode* node);
+  void RemoveSubtree(const bookmarks::BookmarkNode* node);
+  void AddNode(const bookmarks::BookmarkNode* node);
+  void RemoveNode(const bookmarks::BookmarkNode* node);
+  const bookmarks::BookmarkNode* Lookup(const std::string& object_id);
+
+  bookmarks::BookmarkModel* model_;  // Not owned
+
+  std::unordered_map<std::string, const bookmarks::BookmarkNode*>
+      nodes_by_object_id_;
+  std::unordered_map<const bookmarks::BookmarkNode*, std::string>
+      object_ids_by_node_;
+  std::unordered_set<const bookmarks::BookmarkNode*> nodes_without_object_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(BookmarkObjectIdIndex);
+};
+
+}  // namespace brave_sync
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SYNC_BOOKMARK_OBJECT_ID_INDEX_H_
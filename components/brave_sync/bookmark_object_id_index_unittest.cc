@@ -0,0 +1,135 @@
+/* Copyright 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/test/task_environment.h"
+#include "brave/components/brave_sync/bookmark_object_id_index.h"
+#include "brave/components/brave_sync/syncer_helper.h"
+#include "brave/components/brave_sync/tools.h"
+#include "components/bookmarks/browser/bookmark_model.h"
+#include "components/bookmarks/test/test_bookmark_client.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using bookmarks::BookmarkModel;
+using bookmarks::BookmarkNode;
+
+namespace brave_sync {
+
+class BookmarkObjectIdIndexTest : public testing::Test {
+ public:
+  BookmarkObjectIdIndexTest() {}
+  ~BookmarkObjectIdIndexTest() override {}
+
+ protected:
+  void SetUp() override {
+    model_ = bookmarks::TestBookmarkClient::CreateModel();
+    model_->SetNodeMetaInfo(model_->bookmark_bar_node(), "order", "1.0.1");
+    model_->SetNodeMetaInfo(model_->other_node(), "order", "1.0.2");
+  }
+
+  const BookmarkNode* AddURL(const BookmarkNode* parent,
+                             const std::string& object_id) {
+    const BookmarkNode* node =
+        model_->AddURL(parent, parent->children().size(),
+                       base::ASCIIToUTF16(object_id),
+                       GURL("https://" + object_id + ".com/"));
+    if (!object_id.empty())
+      model_->SetNodeMetaInfo(node, "object_id", object_id);
+    return node;
+  }
+
+  BookmarkModel* model() { return model_.get(); }
+
+ private:
+  base::test::TaskEnvironment task_environment_;
+  std::unique_ptr<BookmarkModel> model_;
+};
+
+TEST_F(BookmarkObjectIdIndexTest, FindsNodesByObjectId) {
+  const BookmarkNode* node_a = AddURL(model()->bookmark_bar_node(), "a");
+  BookmarkObjectIdIndex index(model());
+  const BookmarkNode* node_b = AddURL(model()->other_node(), "b");
+
+  EXPECT_EQ(node_a, index.Find("a"));
+  EXPECT_EQ(node_b, index.Find("b"));
+  EXPECT_EQ(nullptr, index.Find("c"));
+  EXPECT_EQ(nullptr, index.Find(""));
+}
+
+TEST_F(BookmarkObjectIdIndexTest, FindsObjectIdsAssignedByAddBraveMetaInfo) {
+  BookmarkObjectIdIndex index(model());
+  const BookmarkNode* node = AddURL(model()->bookmark_bar_node(), "");
+
+  // Assigns the object id without notifying the model observers
+  AddBraveMetaInfo(node);
+  std::string object_id;
+  node->GetMetaInfo("object_id", &object_id);
+  ASSERT_FALSE(object_id.empty());
+
+  EXPECT_EQ(node, index.Find(object_id));
+}
+
+TEST_F(BookmarkObjectIdIndexTest, TracksChangedObjectIds) {
+  BookmarkObjectIdIndex index(model());
+  const BookmarkNode* node = AddURL(model()->bookmark_bar_node(), "a");
+
+  model()->SetNodeMetaInfo(node, "object_id", "b");
+  EXPECT_EQ(nullptr, index.Find("a"));
+  EXPECT_EQ(node, index.Find("b"));
+
+  tools::AsMutable(node)->SetMetaInfo("object_id", "c");
+  index.Update(node);
+  EXPECT_EQ(nullptr, index.Find("b"));
+  EXPECT_EQ(node, index.Find("c"));
+}
+
+TEST_F(BookmarkObjectIdIndexTest, ForgetsRemovedNodes) {
+  BookmarkObjectIdIndex index(model());
+  const BookmarkNode* folder = model()->AddFolder(
+      model()->bookmark_bar_node(), 0, base::ASCIIToUTF16("Folder"));
+  model()->SetNodeMetaInfo(folder, "object_id", "folder");
+  AddURL(folder, "a");
+  ASSERT_NE(nullptr, index.Find("a"));
+
+  model()->Remove(folder);
+  EXPECT_EQ(nullptr, index.Find("folder"));
+  EXPECT_EQ(nullptr, index.Find("a"));
+
+  const BookmarkNode* node = AddURL(model()->other_node(), "b");
+  model()->RemoveAllUserBookmarks();
+  EXPECT_EQ(nullptr, index.Find("b"));
+
+  node = AddURL(model()->other_node(), "b");
+  EXPECT_EQ(node, index.Find("b"));
+}
+
+TEST_F(BookmarkObjectIdIndexTest, FindsNodesInFolders) {
+  std::vector<const BookmarkNode*> nodes;
+  for (int i = 0; i < 3; ++i) {
+    const BookmarkNode* folder = model()->AddFolder(
+        model()->bookmark_bar_node(), i,
+        base::ASCIIToUTF16("Folder" + base::NumberToString(i)));
+    for (int j = 0; j < 3; ++j) {
+      nodes.push_back(AddURL(folder, base::NumberToString(i) + "." +
+                                         base::NumberToString(j)));
+    }
+  }
+
+  BookmarkObjectIdIndex index(model());
+  for (const BookmarkNode* node : nodes) {
+    std::string object_id;
+    node->GetMetaInfo("object_id", &object_id);
+    EXPECT_EQ(node, index.Find(object_id));
+  }
+  EXPECT_EQ(nullptr, index.Find("unknown.0"));
+}
+
+}  // namespace brave_sync
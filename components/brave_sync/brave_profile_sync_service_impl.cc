@@ -14,6 +14,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_sync/bookmark_object_id_index.h"
 #include "brave/components/brave_sync/brave_sync_prefs.h"
 #include "brave/components/brave_sync/brave_sync_service_observer.h"
 #include "brave/components/brave_sync/client/brave_sync_client_impl.h"
@@ -22,6 +23,7 @@
 #include "brave/components/brave_sync/jslib_messages.h"
 #include "brave/components/brave_sync/settings.h"
 #include "brave/components/brave_sync/sync_devices.h"
+#include "brave/components/brave_sync/sync_records_resend_queue.h"
 #include "brave/components/brave_sync/syncer_helper.h"
 #include "brave/components/brave_sync/tools.h"
 #include "brave/components/brave_sync/values_conv.h"
@@ -34,7 +36,6 @@
 #include "components/sync/engine_impl/syncer.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/network_interfaces.h"
-#include "ui/base/models/tree_node_iterator.h"
 
 namespace brave_sync {
 
@@ -104,21 +105,6 @@ RecordsListPtr CreateDeviceRecord(const std::string& device_name,
   return records;
 }
 
-const bookmarks::BookmarkNode* FindByObjectId(bookmarks::BookmarkModel* model,
-                                              const std::string& object_id) {
-  ui::TreeNodeIterator<const bookmarks::BookmarkNode> iterator(
-      model->root_node());
-  while (iterator.has_next()) {
-    const bookmarks::BookmarkNode* node = iterator.Next();
-    std::string node_object_id;
-    node->GetMetaInfo("object_id", &node_object_id);
-
-    if (!node_object_id.empty() && object_id == node_object_id)
-      return node;
-  }
-  return nullptr;
-}
-
 std::unique_ptr<SyncRecord> CreateDeleteBookmarkByObjectId(
     const prefs::Prefs* brave_sync_prefs,
     const std::string& object_id) {
@@ -173,6 +159,10 @@ BraveProfileSyncServiceImpl::BraveProfileSyncServiceImpl(Profile* profile,
       brave_sync_client_(BraveSyncClient::Create(this, profile)) {
   brave_sync_prefs_ =
       std::make_unique<prefs::Prefs>(sync_client_->GetPrefService());
+  records_to_resend_ = std::make_unique<SyncRecordsResendQueue>(
+      brave_sync_prefs_.get(), kMaxSendRetries,
+      base::BindRepeating(
+          &BraveProfileSyncServiceImpl::GetRetryExponentialWaitAmount));
 
   // Monitor syncs prefs required in GetSettingsAndDevices
   brave_pref_change_registrar_.Init(sync_client_->GetPrefService());
@@ -398,6 +388,7 @@ void BraveProfileSyncServiceImpl::OnSyncDebug(const std::string& message) {
 void BraveProfileSyncServiceImpl::OnSyncSetupError(const std::string& error) {
   if (brave_sync_initializing_) {
     brave_sync_prefs_->Clear();
+    records_to_resend_->Clear();
     brave_sync_initializing_ = false;
   }
   NotifySyncSetupError(error);
@@ -647,7 +638,7 @@ void BraveProfileSyncServiceImpl::OnRecordsSent(
   if (category == kBookmarks) {
     for (auto& record : *records) {
       // Remove Acked sent records
-      brave_sync_prefs_->RemoveFromRecordsToResend(record->objectId);
+      records_to_resend_->Remove(record->objectId);
     }
   } else if (category == kPreferences && pending_self_reset_) {
     ResetSyncInternal();
@@ -686,6 +677,7 @@ void BraveProfileSyncServiceImpl::OnConnectionChanged(
 
 void BraveProfileSyncServiceImpl::Shutdown() {
   SignalWaitableEvent();
+  object_id_index_.reset();
   syncer::ProfileSyncService::Shutdown();
 }
 
@@ -712,6 +704,7 @@ void BraveProfileSyncServiceImpl::NotifyHaveSyncWords(
 void BraveProfileSyncServiceImpl::ResetSyncInternal() {
   SignalWaitableEvent();
   brave_sync_prefs_->Clear();
+  records_to_resend_->Clear();
 
   brave_sync_ready_ = false;
 
@@ -795,7 +788,7 @@ BraveProfileSyncServiceImpl::BookmarkNodeToSyncBookmark(
 
 void BraveProfileSyncServiceImpl::SaveSyncEntityInfo(
     const jslib::SyncRecord* record) {
-  auto* node = FindByObjectId(model_, record->objectId);
+  auto* node = FindByObjectId(record->objectId);
   // no need to save for DELETE
   if (node) {
     auto& bookmark = record->GetBookmark();
@@ -820,7 +813,7 @@ void BraveProfileSyncServiceImpl::LoadSyncEntityInfo(
   auto* bookmark = record->mutable_bookmark();
   if (!bookmark->metaInfo.empty())
     return;
-  auto* node = FindByObjectId(model_, record->objectId);
+  auto* node = FindByObjectId(record->objectId);
   if (node) {
     AddSyncEntityInfo(bookmark, node, "position_in_parent");
     AddSyncEntityInfo(bookmark, node, "version");
@@ -860,16 +853,14 @@ void BraveProfileSyncServiceImpl::ProcessOtherBookmarksFolder(
     // iteration
   if (!model_->other_node()->GetMetaInfo("object_id", &other_node_object_id) &&
       record->action == jslib::SyncRecord::Action::A_CREATE) {
-    tools::AsMutable(model_->other_node())->SetMetaInfo("object_id",
-                                                        record->objectId);
+    SetOtherNodeObjectId(record->objectId);
   } else {
     // Out-of-date desktop will poll remote records before commiting local
     // changes so we won't get old iteration id. That is why we always take
     // remote id when it is different than what we have to catch up with current
     // iteration
     if (other_node_object_id != record->objectId) {
-      tools::AsMutable(model_->other_node())->SetMetaInfo("object_id",
-                                                          record->objectId);
+      SetOtherNodeObjectId(record->objectId);
     }
     // DELETE won't reach here, because [DELETE, null] => [] in
     // resolve-sync-objects but children records will go through. And we don't
@@ -885,11 +876,8 @@ void BraveProfileSyncServiceImpl::ProcessOtherBookmarksFolder(
         bookmark.site.customTitle != tools::kOtherNodeName) {
       // Generate next iteration object id from current object_id which will be
       // used to mapped normal folder
-      tools::AsMutable(
-        model_->other_node())
-          ->SetMetaInfo("object_id",
-                        tools::GenerateObjectIdForOtherNode(
-                          other_node_object_id));
+      SetOtherNodeObjectId(
+          tools::GenerateObjectIdForOtherNode(other_node_object_id));
       *pass_to_syncer = true;
 
       // Add records to move direct children of other_node to this new folder
@@ -938,8 +926,7 @@ void BraveProfileSyncServiceImpl::CheckOtherBookmarkRecord(
   if (!model_->other_node()->GetMetaInfo("object_id", &other_node_object_id)) {
     // first iteration
     other_node_object_id = tools::GenerateObjectIdForOtherNode(std::string());
-    tools::AsMutable(model_->other_node())->SetMetaInfo("object_id",
-                                                        other_node_object_id);
+    SetOtherNodeObjectId(other_node_object_id);
   }
   DCHECK(!other_node_object_id.empty());
   if (record->objectId != other_node_object_id)
@@ -957,6 +944,21 @@ void BraveProfileSyncServiceImpl::CheckOtherBookmarkChildRecord(
   }
 }
 
+const bookmarks::BookmarkNode* BraveProfileSyncServiceImpl::FindByObjectId(
+    const std::string& object_id) {
+  DCHECK(model_);
+  if (!object_id_index_)
+    object_id_index_ = std::make_unique<BookmarkObjectIdIndex>(model_);
+  return object_id_index_->Find(object_id);
+}
+
+void BraveProfileSyncServiceImpl::SetOtherNodeObjectId(
+    const std::string& object_id) {
+  tools::AsMutable(model_->other_node())->SetMetaInfo("object_id", object_id);
+  if (object_id_index_)
+    object_id_index_->Update(model_->other_node());
+}
+
 void BraveProfileSyncServiceImpl::CreateResolveList(
     const std::vector<std::unique_ptr<SyncRecord>>& records,
     SyncRecordAndExistingList* records_and_existing_objects) {
@@ -970,7 +972,7 @@ void BraveProfileSyncServiceImpl::CreateResolveList(
     }
     auto resolved_record = std::make_unique<SyncRecordAndExisting>();
     resolved_record->first = SyncRecord::Clone(*record);
-    auto* node = FindByObjectId(model_, record->objectId);
+    auto* node = FindByObjectId(record->objectId);
     if (node) {
       resolved_record->second = BookmarkNodeToSyncBookmark(node);
     }
@@ -1220,12 +1222,7 @@ void BraveProfileSyncServiceImpl::SendSyncRecords(
     DCHECK(model_->loaded());
     for (auto& record : *records) {
       SaveSyncEntityInfo(record.get());
-      std::unique_ptr<base::DictionaryValue> meta =
-          std::make_unique<base::DictionaryValue>();
-      meta->SetInteger("send_retry_number", 0);
-      meta->SetDouble("sync_timestamp", record->syncTimestamp.ToJsTime());
-      brave_sync_prefs_->AddToRecordsToResend(record->objectId,
-                                              std::move(meta));
+      records_to_resend_->Add(record->objectId, record->syncTimestamp);
     }
   }
 }
@@ -1233,43 +1230,17 @@ void BraveProfileSyncServiceImpl::SendSyncRecords(
 void BraveProfileSyncServiceImpl::ResendSyncRecords(
     const std::string& category_name) {
   if (category_name == kBookmarks) {
-    RecordsListPtr records = std::make_unique<RecordsList>();
-    std::vector<std::string> records_to_resend =
-        brave_sync_prefs_->GetRecordsToResend();
+    const std::vector<std::string> records_to_resend =
+        records_to_resend_->TakeDue(base::Time::Now());
     if (records_to_resend.empty())
       return;
 
     DCHECK(model_);
     DCHECK(model_->loaded());
 
-    for (auto& object_id : records_to_resend) {
-      auto* node = FindByObjectId(model_, object_id);
-
-      // Check resend interval
-      const base::DictionaryValue* meta =
-          brave_sync_prefs_->GetRecordToResendMeta(object_id);
-      DCHECK(meta);
-      int current_retry_number = kMaxSendRetries;
-      meta->GetInteger("send_retry_number", &current_retry_number);
-      DCHECK_GE(current_retry_number, 0);
-      double sync_timestamp = 0;
-      meta->GetDouble("sync_timestamp", &sync_timestamp);
-      DCHECK(!base::Time::FromJsTime(sync_timestamp).is_null());
-
-      if ((base::Time::Now() - base::Time::FromJsTime(sync_timestamp)) <
-          GetRetryExponentialWaitAmount(current_retry_number))
-        continue;
-
-      // Increase retry number
-      if (++current_retry_number > kMaxSendRetries)
-        current_retry_number = kMaxSendRetries;
-      std::unique_ptr<base::DictionaryValue> new_meta =
-          base::DictionaryValue::From(
-              std::make_unique<base::Value>(meta->Clone()));
-      new_meta->SetInteger("send_retry_number", current_retry_number);
-      new_meta->SetDouble("sync_timestamp", base::Time::Now().ToJsTime());
-      brave_sync_prefs_->SetRecordToResendMeta(object_id, std::move(new_meta));
-
+    RecordsListPtr records = std::make_unique<RecordsList>();
+    for (const auto& object_id : records_to_resend) {
+      auto* node = FindByObjectId(object_id);
       if (node) {
         records->push_back(BookmarkNodeToSyncBookmark(node));
       } else {
@@ -71,6 +71,9 @@ namespace prefs {
 class Prefs;
 }  // namespace prefs
 
+class BookmarkObjectIdIndex;
+class SyncRecordsResendQueue;
+
 using bookmarks::BookmarkModel;
 using bookmarks::BookmarkNode;
 
@@ -259,6 +262,8 @@ class BraveProfileSyncServiceImpl
 
   std::unique_ptr<jslib::SyncRecord> BookmarkNodeToSyncBookmark(
       const bookmarks::BookmarkNode* node);
+  const bookmarks::BookmarkNode* FindByObjectId(const std::string& object_id);
+  void SetOtherNodeObjectId(const std::string& object_id);
   // These SyncEntityInfo is for legacy device who doesn't send meta info for
   // sync entity
   void SaveSyncEntityInfo(const jslib::SyncRecord* record);
@@ -302,6 +307,9 @@ class BraveProfileSyncServiceImpl
 
   std::unique_ptr<brave_sync::prefs::Prefs> brave_sync_prefs_;
 
+  // Sent bookmark records which have not been confirmed yet
+  std::unique_ptr<SyncRecordsResendQueue> records_to_resend_;
+
   // True if we have received SyncReady from JS lib
   // This is used only to prevent out of sequence invocation of OnSaveInitData
   // and prevent double invocation of OnSyncReady
@@ -323,6 +331,9 @@ class BraveProfileSyncServiceImpl
 
   bookmarks::BookmarkModel* model_ = nullptr;
 
+  // Created on the first lookup by object id
+  std::unique_ptr<BookmarkObjectIdIndex> object_id_index_;
+
   std::unique_ptr<BraveSyncClient> brave_sync_client_;
 
   std::unique_ptr<RecordsList> pending_received_records_;
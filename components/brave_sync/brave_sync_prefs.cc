@@ -15,6 +15,7 @@
 
 void MigrateBraveSyncPrefs(PrefService* prefs) {
   prefs->ClearPref(brave_sync::prefs::kSyncPrevSeed);
+  prefs->ClearPref(brave_sync::prefs::kSyncRecordsToResend);
 }
 
 namespace brave_sync {
@@ -234,25 +235,11 @@ void Prefs::SetMigratedBookmarksVersion(const int migrate_bookmarks) {
   pref_service_->SetInteger(kSyncMigrateBookmarksVersion, migrate_bookmarks);
 }
 
-std::vector<std::string> Prefs::GetRecordsToResend() const {
-  std::vector<std::string> result;
-  const base::Value* records = pref_service_->GetList(kSyncRecordsToResend);
-  for (const base::Value& record : records->GetList()) {
-    result.push_back(record.GetString());
-  }
-  return result;
-}
-
-void Prefs::AddToRecordsToResend(const std::string& object_id,
-                                 std::unique_ptr<base::DictionaryValue> meta) {
-  ListPrefUpdate list_update(pref_service_, kSyncRecordsToResend);
-  list_update->GetList().emplace_back(object_id);
-  SetRecordToResendMeta(object_id, std::move(meta));
+const base::DictionaryValue* Prefs::GetRecordsToResendMeta() const {
+  return pref_service_->GetDictionary(kSyncRecordsToResendMeta);
 }
 
 void Prefs::RemoveFromRecordsToResend(const std::string& object_id) {
-  ListPrefUpdate list_update(pref_service_, kSyncRecordsToResend);
-  base::Erase(list_update->GetList(), base::Value(object_id));
   DictionaryPrefUpdate dict_update(pref_service_, kSyncRecordsToResendMeta);
   dict_update->RemoveKey(object_id);
 }
@@ -68,9 +68,10 @@ extern const char kSyncApiVersion[];
 // The version of bookmarks state: 0,1,... .
 // Current to migrate to is 1.
 extern const char kSyncMigrateBookmarksVersion[];
-// Cached object_id list for unconfirmed records
+// Deprecated, the object ids of unconfirmed records are the keys of
+// kSyncRecordsToResendMeta
 extern const char kSyncRecordsToResend[];
-// Meta info of kSyncRecordsToResend
+// Dictionary of unconfirmed records meta info, keyed by object_id
 extern const char kSyncRecordsToResendMeta[];
 
 class Prefs {
@@ -121,9 +122,7 @@ class Prefs {
   int GetMigratedBookmarksVersion();
   void SetMigratedBookmarksVersion(const int);
 
-  std::vector<std::string> GetRecordsToResend() const;
-  void AddToRecordsToResend(const std::string& object_id,
-                            std::unique_ptr<base::DictionaryValue> meta);
+  const base::DictionaryValue* GetRecordsToResendMeta() const;
   void RemoveFromRecordsToResend(const std::string& object_id);
   const base::DictionaryValue* GetRecordToResendMeta(
       const std::string& object_id) const;
@@ -19,6 +19,7 @@
 #include "brave/components/brave_sync/jslib_messages.h"
 #include "brave/components/brave_sync/settings.h"
 #include "brave/components/brave_sync/sync_devices.h"
+#include "brave/components/brave_sync/sync_records_resend_queue.h"
 #include "brave/components/brave_sync/test_util.h"
 #include "brave/components/brave_sync/tools.h"
 #include "brave/components/brave_sync/values_conv.h"
@@ -29,6 +30,7 @@
 #include "components/bookmarks/browser/bookmark_utils.h"
 #include "components/bookmarks/test/test_bookmark_client.h"
 #include "components/prefs/pref_service.h"
+#include "components/prefs/scoped_user_pref_update.h"
 #include "components/sync/base/pref_names.h"
 #include "content/public/browser/network_service_instance.h"
 #include "content/public/test/browser_task_environment.h"
@@ -1024,7 +1026,7 @@ TEST_F(BraveSyncServiceTest, ExponentialResend) {
   EXPECT_CALL(*sync_client(), SendSyncRecords(kBookmarks, _)).Times(1);
   sync_service()->SendSyncRecords(kBookmarks, std::move(records));
 
-  EXPECT_EQ(brave_sync_prefs()->GetRecordsToResend().size(), 1u);
+  EXPECT_EQ(sync_service()->records_to_resend_->size(), 1u);
   const base::DictionaryValue* meta =
       brave_sync_prefs()->GetRecordToResendMeta(record_a_object_id);
   int send_retry_number = -1;
@@ -1084,7 +1086,7 @@ TEST_F(BraveSyncServiceTest, ExponentialResend) {
   sent_records->at(0)->syncTimestamp = timestamp_resolve;
   sync_service()->OnRecordsSent(kBookmarks, std::move(sent_records));
 
-  EXPECT_EQ(brave_sync_prefs()->GetRecordsToResend().size(), 0u);
+  EXPECT_EQ(sync_service()->records_to_resend_->size(), 0u);
   EXPECT_EQ(brave_sync_prefs()->GetRecordToResendMeta(record_a_object_id),
             nullptr);
 }
@@ -1186,6 +1188,20 @@ TEST_F(BraveSyncServiceTest, MigratePrevSeed) {
             "");
 }
 
+TEST_F(BraveSyncServiceTest, MigrateRecordsToResend) {
+  {
+    ListPrefUpdate list_update(profile()->GetPrefs(),
+                               brave_sync::prefs::kSyncRecordsToResend);
+    list_update->GetList().emplace_back("1, 2, 3");
+  }
+  MigrateBraveSyncPrefs(profile()->GetPrefs());
+  EXPECT_TRUE(profile()
+                  ->GetPrefs()
+                  ->GetList(brave_sync::prefs::kSyncRecordsToResend)
+                  ->GetList()
+                  .empty());
+}
+
 TEST_F(BraveSyncServiceTest, InitialFetchesStartWithZero) {
   EXPECT_CALL(*sync_client(), SendCompact(kBookmarks)).Times(1);
   EXPECT_CALL(*sync_client(), SendFetchSyncRecords(_, base::Time(), _))
@@ -0,0 +1,127 @@
+/* Copyright 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_sync/sync_records_resend_queue.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "base/values.h"
+#include "brave/components/brave_sync/brave_sync_prefs.h"
+
+namespace brave_sync {
+
+SyncRecordsResendQueue::SyncRecordsResendQueue(
+    prefs::Prefs* prefs,
+    int max_retry_number,
+    GetWaitAmountCallback get_wait_amount)
+    : prefs_(prefs),
+      max_retry_number_(max_retry_number),
+      get_wait_amount_(std::move(get_wait_amount)) {
+  DCHECK(prefs_);
+  DCHECK_GE(max_retry_number_, 0);
+  Load();
+}
+
+SyncRecordsResendQueue::~SyncRecordsResendQueue() {}
+
+void SyncRecordsResendQueue::Add(const std::string& object_id,
+                                 const base::Time& sync_timestamp) {
+  DCHECK(!object_id.empty());
+  Unschedule(object_id);
+
+  Entry entry;
+  entry.sync_timestamp = sync_timestamp;
+  Schedule(object_id, entry);
+  Save(object_id, entry);
+}
+
+void SyncRecordsResendQueue::Remove(const std::string& object_id) {
+  if (!entries_.count(object_id))
+    return;
+
+  Unschedule(object_id);
+  prefs_->RemoveFromRecordsToResend(object_id);
+}
+
+std::vector<std::string> SyncRecordsResendQueue::TakeDue(
+    const base::Time& now) {
+  std::vector<std::string> object_ids;
+  for (auto it = deadlines_.begin();
+       it != deadlines_.end() && it->first <= now; ++it) {
+    object_ids.push_back(it->second);
+  }
+
+  for (const auto& object_id : object_ids) {
+    Entry entry = entries_[object_id];
+    Unschedule(object_id);
+
+    entry.send_retry_number =
+        std::min(entry.send_retry_number + 1, max_retry_number_);
+    entry.sync_timestamp = now;
+    Schedule(object_id, entry);
+    Save(object_id, entry);
+  }
+
+  return object_ids;
+}
+
+void SyncRecordsResendQueue::Clear() {
+  entries_.clear();
+  deadlines_.clear();
+}
+
+size_t SyncRecordsResendQueue::size() const {
+  return entries_.size();
+}
+
+void SyncRecordsResendQueue::Load() {
+  const base::DictionaryValue* records = prefs_->GetRecordsToResendMeta();
+  if (!records)
+    return;
+
+  for (const auto& record : records->DictItems()) {
+    if (!record.second.is_dict())
+      continue;
+
+    Entry entry;
+    entry.send_retry_number =
+        record.second.FindIntKey("send_retry_number").value_or(
+            max_retry_number_);
+    entry.send_retry_number =
+        std::max(0, std::min(entry.send_retry_number, max_retry_number_));
+    entry.sync_timestamp = base::Time::FromJsTime(
+        record.second.FindDoubleKey("sync_timestamp").value_or(0));
+    Schedule(record.first, entry);
+  }
+}
+
+void SyncRecordsResendQueue::Schedule(const std::string& object_id,
+                                      const Entry& entry) {
+  Entry scheduled_entry = entry;
+  scheduled_entry.deadline =
+      entry.sync_timestamp + get_wait_amount_.Run(entry.send_retry_number);
+  deadlines_.emplace(scheduled_entry.deadline, object_id);
+  entries_[object_id] = scheduled_entry;
+}
+
+void SyncRecordsResendQueue::Unschedule(const std::string& object_id) {
+  auto it = entries_.find(object_id);
+  if (it == entries_.end())
+    return;
+
+  deadlines_.erase(std::make_pair(it->second.deadline, object_id));
+  entries_.erase(it);
+}
+
+void SyncRecordsResendQueue::Save(const std::string& object_id,
+                                  const Entry& entry) {
+  auto meta = std::make_unique<base::DictionaryValue>();
+  meta->SetInteger("send_retry_number", entry.send_retry_number);
+  meta->SetDouble("sync_timestamp", entry.sync_timestamp.ToJsTime());
+  prefs_->SetRecordToResendMeta(object_id, std::move(meta));
+}
+
+}  // namespace brave_sync
@@ -0,0 +1,77 @@
+/* Copyright 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SYNC_SYNC_RECORDS_RESEND_QUEUE_H_
+#define BRAVE_COMPONENTS_BRAVE_SYNC_SYNC_RECORDS_RESEND_QUEUE_H_
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+
+namespace brave_sync {
+
+namespace prefs {
+class Prefs;
+}  // namespace prefs
+
+// Sent records which have not been confirmed by the sync server yet, ordered
+// by the time they are due to be sent again. Only the entries which change
+// are written to prefs::kSyncRecordsToResendMeta.
+class SyncRecordsResendQueue {
+ public:
+  // Returns how long to wait before a record which has been resent
+  // |retry_number| times is due again
+  using GetWaitAmountCallback =
+      base::RepeatingCallback<base::TimeDelta(int retry_number)>;
+
+  SyncRecordsResendQueue(prefs::Prefs* prefs,
+                         int max_retry_number,
+                         GetWaitAmountCallback get_wait_amount);
+  ~SyncRecordsResendQueue();
+
+  void Add(const std::string& object_id, const base::Time& sync_timestamp);
+  void Remove(const std::string& object_id);
+
+  // Returns the object ids of the records which are due at |now| and
+  // schedules their next retry
+  std::vector<std::string> TakeDue(const base::Time& now);
+
+  // Forgets all records without touching prefs, which are cleared by
+  // prefs::Prefs::Clear
+  void Clear();
+
+  size_t size() const;
+
+ private:
+  struct Entry {
+    int send_retry_number = 0;
+    base::Time sync_timestamp;
+    base::Time deadline;
+  };
+
+  void Load();
+  void Schedule(const std::string& object_id, const Entry& entry);
+  void Unschedule(const std::string& object_id);
+  void Save(const std::string& object_id, const Entry& entry);
+
+  prefs::Prefs* prefs_;  // Not owned
+  const int max_retry_number_;
+  GetWaitAmountCallback get_wait_amount_;
+
+  std::unordered_map<std::string, Entry> entries_;
+  std::set<std::pair<base::Time, std::string>> deadlines_;
+
+  DISALLOW_COPY_AND_ASSIGN(SyncRecordsResendQueue);
+};
+
+}  // namespace brave_sync
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SYNC_SYNC_RECORDS_RESEND_QUEUE_H_
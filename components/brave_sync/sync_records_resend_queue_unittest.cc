@@ -0,0 +1,138 @@
+/* Copyright 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/values.h"
+#include "brave/components/brave_sync/brave_sync_prefs.h"
+#include "brave/components/brave_sync/sync_records_resend_queue.h"
+#include "components/pref_registry/pref_registry_syncable.h"
+#include "components/sync_preferences/testing_pref_service_syncable.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_sync {
+
+namespace {
+
+const int kMaxRetryNumber = 2;
+
+base::TimeDelta GetWaitAmount(int retry_number) {
+  return base::TimeDelta::FromMinutes(10 << retry_number);
+}
+
+}  // namespace
+
+class SyncRecordsResendQueueTest : public testing::Test {
+ public:
+  SyncRecordsResendQueueTest() {}
+  ~SyncRecordsResendQueueTest() override {}
+
+ protected:
+  void SetUp() override {
+    prefs::Prefs::RegisterProfilePrefs(pref_service_.registry());
+    prefs_ = std::make_unique<prefs::Prefs>(&pref_service_);
+    queue_ = CreateQueue();
+  }
+
+  std::unique_ptr<SyncRecordsResendQueue> CreateQueue() {
+    return std::make_unique<SyncRecordsResendQueue>(
+        prefs_.get(), kMaxRetryNumber, base::BindRepeating(&GetWaitAmount));
+  }
+
+  int GetPersistedRetryNumber(const std::string& object_id) {
+    const base::DictionaryValue* meta =
+        prefs_->GetRecordToResendMeta(object_id);
+    if (!meta)
+      return -1;
+    return meta->FindIntKey("send_retry_number").value_or(-1);
+  }
+
+  base::Time Minutes(int minutes) {
+    return start_time_ + base::TimeDelta::FromMinutes(minutes);
+  }
+
+  SyncRecordsResendQueue* queue() { return queue_.get(); }
+
+  const base::Time start_time_ = base::Time::Now();
+  sync_preferences::TestingPrefServiceSyncable pref_service_;
+  std::unique_ptr<prefs::Prefs> prefs_;
+  std::unique_ptr<SyncRecordsResendQueue> queue_;
+};
+
+TEST_F(SyncRecordsResendQueueTest, TakesRecordsWhenDue) {
+  queue()->Add("a", Minutes(0));
+  queue()->Add("b", Minutes(5));
+
+  EXPECT_TRUE(queue()->TakeDue(Minutes(9)).empty());
+  EXPECT_EQ(std::vector<std::string>({"a"}), queue()->TakeDue(Minutes(10)));
+  EXPECT_EQ(1, GetPersistedRetryNumber("a"));
+  EXPECT_EQ(0, GetPersistedRetryNumber("b"));
+
+  // "a" is due again 20 minutes after it was resent
+  EXPECT_EQ(std::vector<std::string>({"b"}), queue()->TakeDue(Minutes(29)));
+  EXPECT_EQ(std::vector<std::string>({"a"}), queue()->TakeDue(Minutes(30)));
+  EXPECT_EQ(2u, queue()->size());
+}
+
+TEST_F(SyncRecordsResendQueueTest, CapsRetryNumber) {
+  queue()->Add("a", Minutes(0));
+
+  EXPECT_EQ(1u, queue()->TakeDue(Minutes(10)).size());
+  EXPECT_EQ(1u, queue()->TakeDue(Minutes(30)).size());
+  EXPECT_EQ(1u, queue()->TakeDue(Minutes(70)).size());
+  EXPECT_EQ(kMaxRetryNumber, GetPersistedRetryNumber("a"));
+  EXPECT_TRUE(queue()->TakeDue(Minutes(109)).empty());
+  EXPECT_EQ(1u, queue()->TakeDue(Minutes(110)).size());
+  EXPECT_EQ(kMaxRetryNumber, GetPersistedRetryNumber("a"));
+}
+
+TEST_F(SyncRecordsResendQueueTest, RemovesConfirmedRecords) {
+  queue()->Add("a", Minutes(0));
+  queue()->Add("b", Minutes(0));
+
+  queue()->Remove("a");
+  queue()->Remove("c");
+  EXPECT_EQ(1u, queue()->size());
+  EXPECT_EQ(-1, GetPersistedRetryNumber("a"));
+  EXPECT_EQ(std::vector<std::string>({"b"}), queue()->TakeDue(Minutes(10)));
+}
+
+TEST_F(SyncRecordsResendQueueTest, AddingAgainRestartsRetries) {
+  queue()->Add("a", Minutes(0));
+  EXPECT_EQ(1u, queue()->TakeDue(Minutes(10)).size());
+
+  queue()->Add("a", Minutes(15));
+  EXPECT_EQ(1u, queue()->size());
+  EXPECT_EQ(0, GetPersistedRetryNumber("a"));
+  EXPECT_TRUE(queue()->TakeDue(Minutes(24)).empty());
+  EXPECT_EQ(1u, queue()->TakeDue(Minutes(25)).size());
+}
+
+TEST_F(SyncRecordsResendQueueTest, LoadsPersistedRecords) {
+  queue()->Add("a", Minutes(0));
+  queue()->Add("b", Minutes(0));
+  EXPECT_EQ(2u, queue()->TakeDue(Minutes(10)).size());
+  queue()->Remove("b");
+
+  queue_ = CreateQueue();
+  EXPECT_EQ(1u, queue()->size());
+  EXPECT_TRUE(queue()->TakeDue(Minutes(29)).empty());
+  EXPECT_EQ(std::vector<std::string>({"a"}), queue()->TakeDue(Minutes(30)));
+}
+
+TEST_F(SyncRecordsResendQueueTest, ClearForgetsRecords) {
+  queue()->Add("a", Minutes(0));
+  prefs_->Clear();
+  queue()->Clear();
+
+  EXPECT_EQ(0u, queue()->size());
+  EXPECT_TRUE(queue()->TakeDue(Minutes(10)).empty());
+  EXPECT_EQ(0u, CreateQueue()->size());
+}
+
+}  // namespace brave_sync
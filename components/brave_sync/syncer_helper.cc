@@ -6,6 +6,7 @@
 #include "brave/components/brave_sync/syncer_helper.h"
 
 #include "base/strings/string_number_conversions.h"
+#include "brave/components/brave_sync/bookmark_object_id_index.h"
 #include "brave/components/brave_sync/bookmark_order_util.h"
 #include "brave/components/brave_sync/tools.h"
 #include "components/bookmarks/browser/bookmark_node.h"
@@ -87,6 +88,7 @@ void AddBraveMetaInfo(const bookmarks::BookmarkNode* node) {
     object_id = tools::GenerateObjectId();
   }
   tools::AsMutable(node)->SetMetaInfo("object_id", object_id);
+  BookmarkObjectIdIndex::OnObjectIdAssigned(node);
 
   std::string parent_object_id;
   // other_node object id will be empty for the first time, it will be
@@ -51,8 +51,9 @@ GreaselionPreconditionValue GreaselionRule::ParsePrecondition(
   return value;
 }
 
-GreaselionRule::GreaselionRule(const std::string& name)
-    : name_(name), weak_factory_(this) {}
+GreaselionRule::GreaselionRule(const std::string& name) : name_(name) {}
+
+GreaselionRule::GreaselionRule(const GreaselionRule& other) = default;
 
 void GreaselionRule::Parse(base::DictionaryValue* preconditions_value,
                            base::ListValue* urls_value,
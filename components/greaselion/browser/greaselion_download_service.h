@@ -39,9 +39,12 @@ struct GreaselionPreconditions {
   GreaselionPreconditionValue twitter_tips_enabled;
 };
 
+// Rules are copyable so that the Greaselion service can work on its own copy
+// while the download service replaces its rules.
 class GreaselionRule {
  public:
   explicit GreaselionRule(const std::string& name);
+  GreaselionRule(const GreaselionRule& other);
   void Parse(base::DictionaryValue* preconditions_value,
              base::ListValue* urls_value,
              base::ListValue* scripts_value,
@@ -64,8 +67,6 @@ class GreaselionRule {
   std::vector<std::string> url_patterns_;
   std::vector<base::FilePath> scripts_;
   GreaselionPreconditions preconditions_;
-  base::WeakPtrFactory<GreaselionRule> weak_factory_;
-  DISALLOW_COPY_AND_ASSIGN(GreaselionRule);
 };
 
 // The Greaselion download service is in charge
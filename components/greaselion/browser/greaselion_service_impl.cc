@@ -6,6 +6,7 @@
 #include "brave/components/greaselion/browser/greaselion_service_impl.h"
 
 #include <stddef.h>
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -14,12 +15,14 @@
 #include "base/base64.h"
 #include "base/bind.h"
 #include "base/bind_helpers.h"
+#include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/json/json_file_value_serializer.h"
 #include "base/one_shot_event.h"
 #include "base/sequenced_task_runner.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
@@ -29,6 +32,7 @@
 #include "brave/components/greaselion/browser/greaselion_download_service.h"
 #include "chrome/browser/extensions/extension_service.h"
 #include "chrome/common/chrome_paths.h"
+#include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
 #include "extensions/browser/extension_registry.h"
 #include "extensions/browser/extension_system.h"
@@ -51,7 +55,7 @@ namespace {
 // NOTE: The caller takes ownership of the directory at extension->path() on the
 // returned object.
 scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
-    greaselion::GreaselionRule* rule,
+    const greaselion::GreaselionRule& rule,
     const base::FilePath& extensions_dir) {
   base::FilePath install_temp_dir =
       extensions::file_util::GetInstallTempDir(extensions_dir);
@@ -80,7 +84,7 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
   // public key.
   char raw[crypto::kSHA256Length] = {0};
   std::string key;
-  std::string script_name = rule->name();
+  std::string script_name = rule.name();
   crypto::SHA256HashString(kBraveUpdatesExtensionsEndpoint + script_name, raw,
                            crypto::kSHA256Length);
   base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length), &key);
@@ -91,11 +95,11 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
   root->SetStringPath(extensions::manifest_keys::kPublicKey, key);
 
   auto js_files = std::make_unique<base::ListValue>();
-  for (auto script : rule->scripts())
+  for (auto script : rule.scripts())
     js_files->AppendString(script.BaseName().value());
 
   auto matches = std::make_unique<base::ListValue>();
-  for (auto url_pattern : rule->url_patterns())
+  for (auto url_pattern : rule.url_patterns())
     matches->AppendString(url_pattern);
 
   auto content_script = std::make_unique<base::DictionaryValue>();
@@ -125,7 +129,7 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
   }
 
   // Copy the script files to our extension directory.
-  for (auto script : rule->scripts()) {
+  for (auto script : rule.scripts()) {
     if (!base::CopyFile(script, temp_dir.GetPath().Append(script.BaseName()))) {
       LOG(ERROR) << "Could not copy Greaselion script";
       return nullptr;
@@ -161,8 +165,11 @@ GreaselionServiceImpl::GreaselionServiceImpl(
       extension_registry_(extension_registry),
       all_rules_installed_successfully_(true),
       update_in_progress_(false),
+      update_requested_(false),
       pending_installs_(0),
       task_runner_(std::move(task_runner)),
+      script_digests_(new ScriptDigests,
+                      base::OnTaskRunnerDeleter(task_runner_)),
       weak_factory_(this) {
   extension_registry_->AddObserver(this);
   for (int i = FIRST_FEATURE; i != LAST_FEATURE; i++)
@@ -173,62 +180,205 @@ GreaselionServiceImpl::~GreaselionServiceImpl() {
   extension_registry_->RemoveObserver(this);
 }
 
+// Hashes everything the extension built for a Greaselion rule is made of, so
+// that the extension can be reused as long as the hash does not change.
+// The hash of a rule is empty if one of its scripts cannot be read. Scripts
+// whose size and modification time did not change since they were last hashed
+// are not read again.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+// static
+std::vector<std::string> GreaselionServiceImpl::HashRulesOnTaskRunner(
+    const std::vector<GreaselionRule>& rules,
+    ScriptDigests* script_digests) {
+  ScriptDigests used_script_digests;
+  std::vector<std::string> hashes;
+  for (const GreaselionRule& rule : rules) {
+    std::unique_ptr<crypto::SecureHash> hash =
+        crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+    auto update = [&hash](const std::string& data) {
+      // Prefix every part with its length to keep the parts apart.
+      const std::string size = base::NumberToString(data.size()) + ":";
+      hash->Update(size.data(), size.size());
+      hash->Update(data.data(), data.size());
+    };
+
+    update(rule.name());
+    for (const auto& url_pattern : rule.url_patterns())
+      update(url_pattern);
+
+    bool scripts_read = true;
+    for (const auto& script : rule.scripts()) {
+      base::File::Info info;
+      if (!base::GetFileInfo(script, &info)) {
+        LOG(ERROR) << "Could not read Greaselion script";
+        scripts_read = false;
+        break;
+      }
+      auto digest = used_script_digests.find(script);
+      if (digest == used_script_digests.end()) {
+        auto cached = script_digests->find(script);
+        if (cached != script_digests->end() &&
+            cached->second.size == info.size &&
+            cached->second.last_modified == info.last_modified) {
+          digest = used_script_digests.insert(*cached).first;
+        } else {
+          std::string contents;
+          if (!base::ReadFileToString(script, &contents)) {
+            LOG(ERROR) << "Could not read Greaselion script";
+            scripts_read = false;
+            break;
+          }
+          digest = used_script_digests
+                       .emplace(script,
+                                ScriptDigest{info.size, info.last_modified,
+                                             crypto::SHA256HashString(contents)})
+                       .first;
+        }
+      }
+      update(script.BaseName().AsUTF8Unsafe());
+      update(digest->second.digest);
+    }
+
+    if (!scripts_read) {
+      hashes.push_back(std::string());
+      continue;
+    }
+
+    uint8_t digest[crypto::kSHA256Length];
+    hash->Finish(digest, sizeof(digest));
+    hashes.push_back(base::HexEncode(digest, sizeof(digest)));
+  }
+  // Forget the scripts which no rule uses anymore.
+  script_digests->swap(used_script_digests);
+  return hashes;
+}
+
 void GreaselionServiceImpl::UpdateInstalledExtensions() {
-  if (update_in_progress_)
+  if (update_in_progress_) {
+    // Run again once the current update is done, since the rules or the
+    // features may have changed after it started.
+    update_requested_ = true;
     return;
+  }
   update_in_progress_ = true;
-  if (greaselion_extensions_.empty()) {
-    // No Greaselion extensions are currently installed, so we can move on to
-    // the install phase immediately.
+  update_requested_ = false;
+
+  // The download service replaces its rules when the component is updated, so
+  // the update works on copies of them.
+  std::vector<GreaselionRule> rules;
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *download_service_->rules()) {
+    rules.push_back(*rule);
+  }
+  // Hashing reads the script files, so it must run on extension file task
+  // runner, which was passed in in the constructor. |script_digests_| is
+  // deleted on that task runner, after this task.
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&GreaselionServiceImpl::HashRulesOnTaskRunner, rules,
+                     base::Unretained(script_digests_.get())),
+      base::BindOnce(&GreaselionServiceImpl::OnRulesHashed,
+                     weak_factory_.GetWeakPtr(), std::move(rules)));
+}
+
+void GreaselionServiceImpl::OnRulesHashed(std::vector<GreaselionRule> rules,
+                                          std::vector<std::string> hashes) {
+  DCHECK(update_in_progress_);
+  DCHECK_EQ(rules.size(), hashes.size());
+  all_rules_installed_successfully_ = true;
+  rules_to_install_.clear();
+  rule_hashes_.clear();
+
+  // Only the rules which are not installed with the same hash yet need to be
+  // installed.
+  std::set<std::string> matching_hashes;
+  for (size_t i = 0; i < rules.size(); ++i) {
+    if (hashes[i].empty()) {
+      if (rules[i].Matches(state_))
+        all_rules_installed_successfully_ = false;
+      continue;
+    }
+    rule_hashes_.insert(hashes[i]);
+    if (!rules[i].Matches(state_))
+      continue;
+
+    matching_hashes.insert(hashes[i]);
+    auto installed = std::find_if(
+        greaselion_extensions_.begin(), greaselion_extensions_.end(),
+        [&hashes, i](const auto& extension) {
+          return extension.second == hashes[i];
+        });
+    if (installed == greaselion_extensions_.end())
+      rules_to_install_.emplace_back(rules[i], hashes[i]);
+  }
+
+  // The other installed extensions are unloaded first. OnExtensionUnloaded
+  // will be called on each extension, where we will update the
+  // pending_unloads_ set. Once it's empty, that callback will call
+  // CreateAndInstallExtensions().
+  for (const auto& extension : greaselion_extensions_) {
+    if (!matching_hashes.count(extension.second))
+      pending_unloads_.insert(extension.first);
+  }
+  if (pending_unloads_.empty()) {
     CreateAndInstallExtensions();
     return;
   }
 
-  // Make a copy of greaselion_extensions_ to iterate while the original vector
-  // changes.
-  std::vector<extensions::ExtensionId> extensions = greaselion_extensions_;
-  for (auto id : extensions) {
-    // We need to unload all the Greaselion extensions that are already
-    // installed. OnExtensionUnloaded will be called on each extension, where we
-    // will update the greaselion_extensions_ set. Once it's empty, that
-    // callback will call CreateAndInstallExtensions().
+  // Make a copy of pending_unloads_ to iterate while the original set changes.
+  std::set<extensions::ExtensionId> extensions = pending_unloads_;
+  for (const auto& id : extensions) {
     extension_service_->UnloadExtension(
         id, extensions::UnloadedExtensionReason::UPDATE);
   }
 }
 
 void GreaselionServiceImpl::CreateAndInstallExtensions() {
-  DCHECK(greaselion_extensions_.empty());
+  DCHECK(pending_unloads_.empty());
   DCHECK(update_in_progress_);
-  all_rules_installed_successfully_ = true;
-  pending_installs_ = 0;
-  std::vector<std::unique_ptr<GreaselionRule>>* rules =
-      download_service_->rules();
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_)) {
-      pending_installs_ += 1;
+
+  // Drop the extensions built for rules which no longer exist.
+  for (auto it = extension_cache_.begin(); it != extension_cache_.end();) {
+    if (rule_hashes_.count(it->first)) {
+      ++it;
+      continue;
     }
+    // Extensions of rules which no longer exist have just been unloaded.
+    task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(base::IgnoreResult(&base::DeleteFile),
+                                  it->second->path(), true));
+    it = extension_cache_.erase(it);
   }
+
+  pending_installs_ = rules_to_install_.size();
   if (!pending_installs_) {
-    // no rules match, nothing else to do
+    // no rules need to be installed, nothing else to do
     MaybeNotifyObservers();
     return;
   }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_)) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
-      base::PostTaskAndReplyWithResult(
-          task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule.get(), install_directory_),
-          base::BindOnce(&GreaselionServiceImpl::PostConvert,
-                         weak_factory_.GetWeakPtr()));
+
+  std::vector<std::pair<GreaselionRule, std::string>> rules;
+  rules.swap(rules_to_install_);
+  for (const auto& rule : rules) {
+    auto cached = extension_cache_.find(rule.second);
+    if (cached != extension_cache_.end()) {
+      PostConvert(rule.second, cached->second);
+      continue;
     }
+    // Convert script file to component extension. This must run on extension
+    // file task runner, which was passed in in the constructor.
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
+                       rule.first, install_directory_),
+        base::BindOnce(&GreaselionServiceImpl::PostConvert,
+                       weak_factory_.GetWeakPtr(), rule.second));
   }
 }
 
 void GreaselionServiceImpl::PostConvert(
+    const std::string& hash,
     scoped_refptr<extensions::Extension> extension) {
   if (!extension.get()) {
     all_rules_installed_successfully_ = false;
@@ -236,7 +386,8 @@ void GreaselionServiceImpl::PostConvert(
     MaybeNotifyObservers();
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
-    greaselion_extensions_.push_back(extension->id());
+    extension_cache_[hash] = extension;
+    greaselion_extensions_[extension->id()] = hash;
     extension_system_->ready().Post(
         FROM_HERE,
         base::BindOnce(&GreaselionServiceImpl::Install,
@@ -252,9 +403,7 @@ void GreaselionServiceImpl::Install(
 void GreaselionServiceImpl::OnExtensionReady(
     content::BrowserContext* browser_context,
     const extensions::Extension* extension) {
-  auto index = std::find(greaselion_extensions_.begin(),
-                         greaselion_extensions_.end(), extension->id());
-  if (index == greaselion_extensions_.end()) {
+  if (!greaselion_extensions_.count(extension->id())) {
     // not one of ours
     return;
   }
@@ -267,14 +416,12 @@ void GreaselionServiceImpl::OnExtensionUnloaded(
     content::BrowserContext* browser_context,
     const extensions::Extension* extension,
     extensions::UnloadedExtensionReason reason) {
-  auto index = std::find(greaselion_extensions_.begin(),
-                         greaselion_extensions_.end(), extension->id());
-  if (index == greaselion_extensions_.end()) {
+  if (!greaselion_extensions_.erase(extension->id())) {
     // not one of ours
     return;
   }
-  greaselion_extensions_.erase(index);
-  if (update_in_progress_ && greaselion_extensions_.empty()) {
+  if (pending_unloads_.erase(extension->id()) && pending_unloads_.empty()) {
+    DCHECK(update_in_progress_);
     // It's time!
     CreateAndInstallExtensions();
   }
@@ -291,6 +438,10 @@ void GreaselionServiceImpl::RemoveObserver(Observer* observer) {
 void GreaselionServiceImpl::MaybeNotifyObservers() {
   if (!pending_installs_) {
     update_in_progress_ = false;
+    if (update_requested_) {
+      UpdateInstalledExtensions();
+      return;
+    }
     for (Observer& observer : observers_)
       observer.OnExtensionsReady(this, all_rules_installed_successfully_);
   }
@@ -299,6 +450,8 @@ void GreaselionServiceImpl::MaybeNotifyObservers() {
 void GreaselionServiceImpl::SetFeatureEnabled(GreaselionFeature feature,
                                               bool enabled) {
   DCHECK(feature >= 0 && feature < LAST_FEATURE);
+  if (state_[feature] == enabled)
+    return;
   state_[feature] = enabled;
   UpdateInstalledExtensions();
 }
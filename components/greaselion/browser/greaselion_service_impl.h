@@ -6,21 +6,26 @@
 #ifndef BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_SERVICE_IMPL_H_
 #define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_SERVICE_IMPL_H_
 
+#include <stdint.h>
+
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/files/file_path.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "brave/components/greaselion/browser/greaselion_download_service.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
 #include "extensions/common/extension_id.h"
 #include "url/gurl.h"
 
-namespace base {
-class SequencedTaskRunner;
-}
-
 namespace extensions {
 class Extension;
 class ExtensionRegistry;
@@ -30,8 +35,6 @@ class ExtensionSystem;
 
 namespace greaselion {
 
-class GreaselionDownloadService;
-
 class GreaselionServiceImpl : public GreaselionService {
  public:
   explicit GreaselionServiceImpl(
@@ -57,8 +60,23 @@ class GreaselionServiceImpl : public GreaselionService {
                            extensions::UnloadedExtensionReason reason) override;
 
  private:
+  // Digest of the contents of a script file, with the size and modification
+  // time of the file it was computed from.
+  struct ScriptDigest {
+    int64_t size;
+    base::Time last_modified;
+    std::string digest;
+  };
+  using ScriptDigests = std::map<base::FilePath, ScriptDigest>;
+
+  static std::vector<std::string> HashRulesOnTaskRunner(
+      const std::vector<GreaselionRule>& rules,
+      ScriptDigests* script_digests);
+  void OnRulesHashed(std::vector<GreaselionRule> rules,
+                     std::vector<std::string> hashes);
   void CreateAndInstallExtensions();
-  void PostConvert(scoped_refptr<extensions::Extension> extension);
+  void PostConvert(const std::string& hash,
+                   scoped_refptr<extensions::Extension> extension);
   void Install(scoped_refptr<extensions::Extension> extension);
   void MaybeNotifyObservers();
 
@@ -70,10 +88,25 @@ class GreaselionServiceImpl : public GreaselionService {
   extensions::ExtensionRegistry* extension_registry_;  // NOT OWNED
   bool all_rules_installed_successfully_;
   bool update_in_progress_;
+  // Set if an update is requested while another one is in progress.
+  bool update_requested_;
   int pending_installs_;
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<Observer> observers_;
-  std::vector<extensions::ExtensionId> greaselion_extensions_;
+  // Installed extensions and the hashes of the rules they were built from.
+  std::map<extensions::ExtensionId, std::string> greaselion_extensions_;
+  std::set<extensions::ExtensionId> pending_unloads_;
+  // Copies of the rules of the current update which are not installed yet, and
+  // their hashes. The download service may replace its rules meanwhile.
+  std::vector<std::pair<GreaselionRule, std::string>> rules_to_install_;
+  // Hashes of all the current rules.
+  std::set<std::string> rule_hashes_;
+  // Extensions built for the current rules, by rule hash, so that rules can be
+  // installed again without rebuilding them.
+  std::map<std::string, scoped_refptr<extensions::Extension>> extension_cache_;
+  // Digests of the script files hashed so far, so that the files which did not
+  // change are not read again. Only used on |task_runner_|.
+  std::unique_ptr<ScriptDigests, base::OnTaskRunnerDeleter> script_digests_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(GreaselionServiceImpl);
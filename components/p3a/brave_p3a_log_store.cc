@@ -5,9 +5,11 @@
 
 #include "brave/components/p3a/brave_p3a_log_store.h"
 
+#include "base/bind.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/rand_util.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
@@ -41,7 +43,10 @@ BraveP3ALogStore::BraveP3ALogStore(Delegate* delegate,
   DCHECK(local_state);
 }
 
-BraveP3ALogStore::~BraveP3ALogStore() = default;
+BraveP3ALogStore::~BraveP3ALogStore() {
+  // Value updates still waiting for their write.
+  PersistDirtyEntries();
+}
 
 void BraveP3ALogStore::RegisterPrefs(PrefRegistrySimple* registry) {
   registry->RegisterDictionaryPref(kPrefName);
@@ -56,27 +61,18 @@ void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
     unsent_entries_.insert(histogram_name);
   }
 
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  MarkAsDirty(histogram_name);
 }
 
 void BraveP3ALogStore::ResetUploadStamps() {
   // Clear log entries flags.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
   for (auto& pair : log_) {
     if (pair.second.sent) {
       DCHECK(!pair.second.sent_timestamp.is_null());
       DCHECK(!unsent_entries_.contains(pair.first));
 
       pair.second.ResetSentState();
-
-      // Update persistent values.
-      update->SetPath({pair.first, kLogSentKey}, base::Value(pair.second.sent));
-      update->SetPath({pair.first, kLogTimestampKey},
-                      base::Value(pair.second.sent_timestamp.ToDoubleT()));
+      MarkAsDirty(pair.first);
     }
   }
 
@@ -87,6 +83,9 @@ void BraveP3ALogStore::ResetUploadStamps() {
   for (const auto& pair : log_) {
     unsent_entries_.insert(pair.first);
   }
+
+  // The sent state is written right away, see |PersistDirtyEntries|.
+  PersistDirtyEntries();
 }
 
 bool BraveP3ALogStore::has_unsent_logs() const {
@@ -94,14 +93,11 @@ bool BraveP3ALogStore::has_unsent_logs() const {
 }
 
 bool BraveP3ALogStore::has_staged_log() const {
-  return !staged_entry_key_.empty();
+  return !staged_entry_keys_.empty();
 }
 
 const std::string& BraveP3ALogStore::staged_log() const {
-  DCHECK(!staged_entry_key_.empty());
-  auto iter = log_.find(staged_entry_key_);
-  DCHECK(iter != log_.end());
-
+  DCHECK(has_staged_log());
   return staged_log_;
 }
 
@@ -119,13 +115,14 @@ void BraveP3ALogStore::StageNextLog() {
   // Stage the next item.
   DCHECK(has_unsent_logs());
   uint64_t rand_idx = base::RandGenerator(unsent_entries_.size());
-  staged_entry_key_ = *(unsent_entries_.begin() + rand_idx);
-  DCHECK(!log_.find(staged_entry_key_)->second.sent);
+  const std::string& staged_entry_key = *(unsent_entries_.begin() + rand_idx);
+  DCHECK(!log_.find(staged_entry_key)->second.sent);
 
-  uint64_t staged_entry_value = log_[staged_entry_key_].value;
-  staged_log_ = delegate_->Serialize(staged_entry_key_, staged_entry_value);
+  uint64_t staged_entry_value = log_[staged_entry_key].value;
+  staged_log_ = delegate_->Serialize(staged_entry_key, staged_entry_value);
+  staged_entry_keys_ = {staged_entry_key};
 
-  VLOG(2) << "BraveP3ALogStore::StageNextLog: staged " << staged_entry_key_;
+  VLOG(2) << "BraveP3ALogStore::StageNextLog: staged " << staged_entry_key;
 }
 
 void BraveP3ALogStore::DiscardStagedLog() {
@@ -133,25 +130,41 @@ void BraveP3ALogStore::DiscardStagedLog() {
     return;
   }
 
-  // Mark previous staged log as sent.
-  auto log_iter = log_.find(staged_entry_key_);
-  DCHECK(log_iter != log_.end());
-  log_iter->second.MarkAsSent();
+  // Mark previous staged entries as sent.
+  for (const std::string& staged_entry_key : staged_entry_keys_) {
+    auto log_iter = log_.find(staged_entry_key);
+    DCHECK(log_iter != log_.end());
+    log_iter->second.MarkAsSent();
+    MarkAsDirty(staged_entry_key);
+
+    // Erase the entry from the unsent queue.
+    auto unsent_entries_iter = unsent_entries_.find(staged_entry_key);
+    DCHECK(unsent_entries_iter != unsent_entries_.end());
+    unsent_entries_.erase(unsent_entries_iter);
+  }
 
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({log_iter->first, kLogSentKey},
-                  base::Value(log_iter->second.sent));
-  update->SetPath({log_iter->first, kLogTimestampKey},
-                  base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
+  staged_entry_keys_.clear();
+  staged_log_.clear();
 
-  // Erase the entry from the unsent queue.
-  auto unsent_entries_iter = unsent_entries_.find(staged_entry_key_);
-  DCHECK(unsent_entries_iter != unsent_entries_.end());
-  unsent_entries_.erase(unsent_entries_iter);
+  // The sent state is written right away, see |PersistDirtyEntries|.
+  PersistDirtyEntries();
+}
 
-  staged_entry_key_.clear();
-  staged_log_.clear();
+void BraveP3ALogStore::StageAllUnsentLogs() {
+  DCHECK(has_unsent_logs());
+  staged_entry_keys_.assign(unsent_entries_.begin(), unsent_entries_.end());
+  base::RandomShuffle(staged_entry_keys_.begin(), staged_entry_keys_.end());
+
+  std::vector<std::pair<std::string, uint64_t>> staged_entries;
+  staged_entries.reserve(staged_entry_keys_.size());
+  for (const std::string& staged_entry_key : staged_entry_keys_) {
+    DCHECK(!log_.find(staged_entry_key)->second.sent);
+    staged_entries.emplace_back(staged_entry_key, log_[staged_entry_key].value);
+  }
+  staged_log_ = delegate_->SerializeBatch(staged_entries);
+
+  VLOG(2) << "BraveP3ALogStore::StageAllUnsentLogs: staged "
+          << staged_entry_keys_.size() << " entries";
 }
 
 void BraveP3ALogStore::PersistUnsentLogs() const {
@@ -211,4 +224,32 @@ void BraveP3ALogStore::LoadPersistedUnsentLogs() {
   }
 }
 
+void BraveP3ALogStore::MarkAsDirty(const std::string& histogram_name) {
+  if (dirty_entries_.empty()) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&BraveP3ALogStore::PersistDirtyEntries,
+                                  weak_factory_.GetWeakPtr()));
+  }
+  dirty_entries_.insert(histogram_name);
+}
+
+void BraveP3ALogStore::PersistDirtyEntries() {
+  if (dirty_entries_.empty()) {
+    return;
+  }
+
+  DictionaryPrefUpdate update(local_state_, kPrefName);
+  for (const std::string& histogram_name : dirty_entries_) {
+    auto log_iter = log_.find(histogram_name);
+    DCHECK(log_iter != log_.end());
+    const LogEntry& entry = log_iter->second;
+    update->SetPath({histogram_name, kLogValueKey},
+                    base::Value(base::NumberToString(entry.value)));
+    update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+    update->SetPath({histogram_name, kLogTimestampKey},
+                    base::Value(entry.sent_timestamp.ToDoubleT()));
+  }
+  dirty_entries_.clear();
+}
+
 }  // namespace brave
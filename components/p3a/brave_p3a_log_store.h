@@ -7,9 +7,12 @@
 #define BRAVE_COMPONENTS_P3A_BRAVE_P3A_LOG_STORE_H_
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
+#include "base/memory/weak_ptr.h"
 #include "base/strings/string_piece.h"
 #include "base/time/time.h"
 #include "components/metrics/log_store.h"
@@ -19,7 +22,11 @@ class PrefRegistrySimple;
 
 namespace brave {
 
-// Stores all given values in memory and persists in prefs on the fly.
+// Stores all given values in memory and persists in prefs on the fly. Value
+// updates made within one task are persisted with a single pref update, while
+// changes to the sent state are persisted immediately: the service is never
+// destroyed, so a pending write may not happen before exit and values would
+// be sent twice.
 // All logs (not only unsent are persistent), and all logs could be loaded
 // using |LoadPersistedUnsentLogs()|. We should fix this at some point since
 // for now persisted entries never expire.
@@ -30,6 +37,10 @@ class BraveP3ALogStore : public metrics::LogStore {
     // Prepares a string representaion of an entry.
     virtual std::string Serialize(base::StringPiece histogram_name,
                                   uint64_t value) const = 0;
+    // Prepares a string representation of several entries uploaded at once.
+    virtual std::string SerializeBatch(
+        const std::vector<std::pair<std::string, uint64_t>>& entries)
+        const = 0;
     // Returns false if the metric is obsolete and should be cleaned up.
     virtual bool IsActualMetric(base::StringPiece histogram_name) const = 0;
     virtual ~Delegate() {}
@@ -56,6 +67,9 @@ class BraveP3ALogStore : public metrics::LogStore {
   void StageNextLog() override;
   void DiscardStagedLog() override;
 
+  // Stages all unsent entries in random order as a single log.
+  void StageAllUnsentLogs();
+
   // |PersistUnsentLogs| should not be used, since we persist everything
   // on the fly.
   void PersistUnsentLogs() const override;
@@ -80,6 +94,10 @@ class BraveP3ALogStore : public metrics::LogStore {
     base::Time sent_timestamp;  // At the moment only for debugging purposes.
   };
 
+  void MarkAsDirty(const std::string& histogram_name);
+  // Writes the entries changed since the last write with one pref update.
+  void PersistDirtyEntries();
+
   const Delegate* const delegate_ = nullptr;  // Weak.
   PrefService* const local_state_ = nullptr;
 
@@ -87,12 +105,17 @@ class BraveP3ALogStore : public metrics::LogStore {
   base::flat_map<std::string, LogEntry> log_;
   base::flat_set<std::string> unsent_entries_;
 
-  std::string staged_entry_key_;
+  // Entries which are changed in memory but not yet in prefs.
+  base::flat_set<std::string> dirty_entries_;
+
+  std::vector<std::string> staged_entry_keys_;
   std::string staged_log_;
 
   // Not used for now.
   std::string staged_log_hash_;
   std::string staged_log_signature_;
+
+  base::WeakPtrFactory<BraveP3ALogStore> weak_factory_{this};
 };
 
 }  // namespace brave
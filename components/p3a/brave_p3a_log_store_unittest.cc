@@ -0,0 +1,173 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_log_store.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/test/task_environment.h"
+#include "base/values.h"
+#include "components/prefs/pref_change_registrar.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+namespace {
+
+constexpr char kPrefName[] = "p3a.logs";
+
+class TestDelegate : public BraveP3ALogStore::Delegate {
+ public:
+  std::string Serialize(base::StringPiece histogram_name,
+                        uint64_t value) const override {
+    return histogram_name.as_string() + "=" + base::NumberToString(value);
+  }
+
+  // Sorted, so the shuffled order of a batch doesn't matter.
+  std::string SerializeBatch(
+      const std::vector<std::pair<std::string, uint64_t>>& entries)
+      const override {
+    std::vector<std::string> serialized;
+    for (const auto& entry : entries)
+      serialized.push_back(Serialize(entry.first, entry.second));
+    std::sort(serialized.begin(), serialized.end());
+    std::string result;
+    for (const std::string& entry : serialized)
+      result += entry + ";";
+    return result;
+  }
+
+  bool IsActualMetric(base::StringPiece histogram_name) const override {
+    return true;
+  }
+};
+
+}  // namespace
+
+class BraveP3ALogStoreTest : public testing::Test {
+ protected:
+  BraveP3ALogStoreTest() {
+    BraveP3ALogStore::RegisterPrefs(local_state_.registry());
+    log_store_ = std::make_unique<BraveP3ALogStore>(&delegate_, &local_state_);
+    pref_change_registrar_.Init(&local_state_);
+    pref_change_registrar_.Add(
+        kPrefName, base::BindRepeating(&BraveP3ALogStoreTest::OnPrefChanged,
+                                       base::Unretained(this)));
+  }
+
+  void OnPrefChanged() { ++pref_writes_; }
+
+  const base::Value* PersistedEntry(const std::string& histogram_name) {
+    return local_state_.GetDictionary(kPrefName)->FindKey(histogram_name);
+  }
+
+  bool PersistedAsSent(const std::string& histogram_name) {
+    const base::Value* entry = PersistedEntry(histogram_name);
+    return entry && entry->FindBoolKey("sent").value_or(false);
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  TestingPrefServiceSimple local_state_;
+  TestDelegate delegate_;
+  std::unique_ptr<BraveP3ALogStore> log_store_;
+  PrefChangeRegistrar pref_change_registrar_;
+  int pref_writes_ = 0;
+};
+
+TEST_F(BraveP3ALogStoreTest, CoalescesValueUpdates) {
+  log_store_->UpdateValue("Brave.A", 1);
+  log_store_->UpdateValue("Brave.B", 2);
+  log_store_->UpdateValue("Brave.A", 3);
+  EXPECT_EQ(0, pref_writes_);
+  EXPECT_FALSE(PersistedEntry("Brave.A"));
+
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(1, pref_writes_);
+  ASSERT_TRUE(PersistedEntry("Brave.A"));
+  EXPECT_EQ("3", *PersistedEntry("Brave.A")->FindStringKey("value"));
+  ASSERT_TRUE(PersistedEntry("Brave.B"));
+  EXPECT_EQ("2", *PersistedEntry("Brave.B")->FindStringKey("value"));
+
+  // Nothing is left to write.
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(1, pref_writes_);
+}
+
+TEST_F(BraveP3ALogStoreTest, PersistsValueUpdatesOnDestruction) {
+  log_store_->UpdateValue("Brave.A", 1);
+  log_store_.reset();
+  ASSERT_TRUE(PersistedEntry("Brave.A"));
+  EXPECT_EQ("1", *PersistedEntry("Brave.A")->FindStringKey("value"));
+}
+
+TEST_F(BraveP3ALogStoreTest, StagesAllUnsentLogs) {
+  log_store_->UpdateValue("Brave.A", 1);
+  log_store_->UpdateValue("Brave.B", 2);
+  log_store_->UpdateValue("Brave.C", 3);
+  task_environment_.RunUntilIdle();
+
+  log_store_->StageNextLog();
+  log_store_->DiscardStagedLog();
+  ASSERT_TRUE(log_store_->has_unsent_logs());
+
+  // Only the two entries still unsent are staged.
+  log_store_->StageAllUnsentLogs();
+  ASSERT_TRUE(log_store_->has_staged_log());
+  const std::string staged_log = log_store_->staged_log();
+  EXPECT_EQ(2, std::count(staged_log.begin(), staged_log.end(), ';'));
+
+  log_store_->DiscardStagedLog();
+  EXPECT_FALSE(log_store_->has_staged_log());
+  EXPECT_FALSE(log_store_->has_unsent_logs());
+
+  log_store_->ResetUploadStamps();
+  log_store_->StageAllUnsentLogs();
+  EXPECT_EQ("Brave.A=1;Brave.B=2;Brave.C=3;", log_store_->staged_log());
+}
+
+TEST_F(BraveP3ALogStoreTest, PersistsSentStateImmediately) {
+  log_store_->UpdateValue("Brave.A", 1);
+  log_store_->UpdateValue("Brave.B", 2);
+  task_environment_.RunUntilIdle();
+  pref_writes_ = 0;
+
+  log_store_->StageAllUnsentLogs();
+  log_store_->DiscardStagedLog();
+  // Both entries are written with a single update, without waiting for a
+  // task which may not run before exit.
+  EXPECT_EQ(1, pref_writes_);
+  EXPECT_TRUE(PersistedAsSent("Brave.A"));
+  EXPECT_TRUE(PersistedAsSent("Brave.B"));
+
+  log_store_->ResetUploadStamps();
+  EXPECT_EQ(2, pref_writes_);
+  EXPECT_FALSE(PersistedAsSent("Brave.A"));
+  EXPECT_FALSE(PersistedAsSent("Brave.B"));
+}
+
+TEST_F(BraveP3ALogStoreTest, LoadsPersistedLogs) {
+  log_store_->UpdateValue("Brave.A", 1);
+  log_store_->UpdateValue("Brave.B", 2);
+  log_store_->StageAllUnsentLogs();
+  log_store_->DiscardStagedLog();
+  log_store_->UpdateValue("Brave.C", 3);
+  log_store_.reset();
+
+  BraveP3ALogStore log_store(&delegate_, &local_state_);
+  log_store.LoadPersistedUnsentLogs();
+  ASSERT_TRUE(log_store.has_unsent_logs());
+  log_store.StageAllUnsentLogs();
+  EXPECT_EQ("Brave.C=3;", log_store.staged_log());
+}
+
+}  // namespace brave
@@ -141,6 +141,7 @@ void BraveP3AService::Init() {
   VLOG(2) << "BraveP3AService parameters are:"
           << ", average_upload_interval_ = " << average_upload_interval_
           << ", randomize_upload_interval_ = " << randomize_upload_interval_
+          << ", batch_uploads_ = " << batch_uploads_
           << ", upload_server_url_ = " << upload_server_url_.spec()
           << ", rotation_interval_ = " << rotation_interval_;
 
@@ -208,6 +209,18 @@ std::string BraveP3AService::Serialize(base::StringPiece histogram_name,
   return message.SerializeAsString();
 }
 
+std::string BraveP3AService::SerializeBatch(
+    const std::vector<std::pair<std::string, uint64_t>>& entries) const {
+  // Only used with servers accepting PYXIS messages, see
+  // MaybeOverrideSettingsFromCommandLine().
+  brave_pyxis::PyxisMessage message;
+  for (const auto& entry : entries) {
+    prochlo::GenerateProchloMessage(base::HashMetricName(entry.first),
+                                    entry.second, pyxis_meta_, &message);
+  }
+  return message.SerializeAsString();
+}
+
 bool
 BraveP3AService::IsActualMetric(base::StringPiece histogram_name) const {
   static const base::NoDestructor<base::flat_set<base::StringPiece>>
@@ -228,6 +241,10 @@ void BraveP3AService::MaybeOverrideSettingsFromCommandLine() {
     }
   }
 
+  if (cmdline->HasSwitch(switches::kP3ABatchUploads)) {
+    batch_uploads_ = true;
+  }
+
   if (cmdline->HasSwitch(switches::kP3ADoNotRandomizeUploadInterval)) {
     randomize_upload_interval_ = false;
   }
@@ -248,6 +265,15 @@ void BraveP3AService::MaybeOverrideSettingsFromCommandLine() {
       upload_server_url_ = url;
     }
   }
+
+  // Batches are PYXIS messages, which the default server can't decode yet.
+  // It would still accept them, marking the whole rotation as sent.
+  if (batch_uploads_ && upload_server_url_ == GURL(kDefaultUploadServerUrl)) {
+    LOG(WARNING) << "Ignoring --" << switches::kP3ABatchUploads
+                 << " without a PYXIS capable --"
+                 << switches::kP3AUploadServerUrl;
+    batch_uploads_ = false;
+  }
 }
 
 void BraveP3AService::InitPyxisMeta() {
@@ -280,16 +306,25 @@ void BraveP3AService::InitPyxisMeta() {
 void BraveP3AService::StartScheduledUpload() {
   VLOG(2) << "BraveP3AService::StartScheduledUpload at " << base::Time::Now();
   if (!log_store_->has_unsent_logs()) {
-    // We continue to schedule next uploads since new histogram values can
-    // come up at any moment. Maybe it's worth to add a method with more
-    // appropriate name for this situation.
+    // In the batch mode everything is sent till the next rotation or a new
+    // value, which restart the scheduler. Otherwise we continue to schedule
+    // next uploads since new histogram values can come up at any moment.
+    if (batch_uploads_) {
+      upload_scheduler_->Stop();
+    }
+    // Maybe it's worth to add a method with more appropriate name for this
+    // situation.
     upload_scheduler_->UploadFinished(true);
     // Nothing to stage.
     VLOG(2) << "StartScheduledUpload - Nothing to stage.";
     return;
   }
   if (!log_store_->has_staged_log()) {
-    log_store_->StageNextLog();
+    if (batch_uploads_) {
+      log_store_->StageAllUnsentLogs();
+    } else {
+      log_store_->StageNextLog();
+    }
   }
 
   // Only upload if service is enabled.
@@ -330,6 +365,7 @@ void BraveP3AService::OnHistogramChangedOnUI(base::StringPiece histogram_name,
     histogram_values_[histogram_name] = bucket;
   } else {
     log_store_->UpdateValue(histogram_name.as_string(), bucket);
+    MaybeResumeBatchUploads();
   }
 }
 
@@ -354,10 +390,18 @@ void BraveP3AService::DoRotation() {
   VLOG(2) << "BraveP3AService doing rotation at " << base::Time::Now();
   log_store_->ResetUploadStamps();
   UpdateRotationTimer();
+  MaybeResumeBatchUploads();
 
   local_state_->SetTime(kLastRotationTimeStampPref, base::Time::Now());
 }
 
+void BraveP3AService::MaybeResumeBatchUploads() {
+  // |upload_scheduler_| is created after the initial rotation.
+  if (batch_uploads_ && upload_scheduler_ && log_store_->has_unsent_logs()) {
+    upload_scheduler_->Start();
+  }
+}
+
 void BraveP3AService::UpdateRotationTimer() {
   base::TimeDelta next_rotation = rotation_interval_.is_zero()
                                       ? TimeDeltaTillMonday(base::Time::Now())
@@ -8,6 +8,8 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/memory/ref_counted.h"
@@ -46,6 +48,9 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // BraveP3ALogStore::Delegate
   std::string Serialize(base::StringPiece histogram_name,
                         uint64_t value) const override;
+  std::string SerializeBatch(
+      const std::vector<std::pair<std::string, uint64_t>>& entries)
+      const override;
 
   bool IsActualMetric(base::StringPiece histogram_name) const override;
 
@@ -73,6 +78,10 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // Restart the uploading process (i.e. mark all values as unsent).
   void DoRotation();
 
+  // Restarts the upload scheduler stopped by the batch mode once there are
+  // values to send.
+  void MaybeResumeBatchUploads();
+
   void UpdateRotationTimer();
 
   // General prefs:
@@ -82,6 +91,8 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // The average interval between uploading different values.
   base::TimeDelta average_upload_interval_;
   bool randomize_upload_interval_ = true;
+  // Whether all unsent values are uploaded in one request.
+  bool batch_uploads_ = false;
   // Interval between rotations, only used for testing from the command line.
   base::TimeDelta rotation_interval_;
   GURL upload_server_url_;
@@ -12,6 +12,12 @@ namespace switches {
 // Interval between sending two values.
 constexpr char kP3AUploadIntervalSeconds[] = "p3a-upload-interval-seconds";
 
+// Upload all unsent values of the current rotation at once, shuffled and
+// encrypted in a single PYXIS message, instead of one value per upload.
+// Ignored unless |kP3AUploadServerUrl| points to a server decoding PYXIS
+// messages, since the default one only accepts single raw values.
+constexpr char kP3ABatchUploads[] = "p3a-batch-uploads";
+
 // Avoid upload interval randomization.
 constexpr char kP3ADoNotRandomizeUploadInterval[] =
     "p3a-do-not-randomize-upload-interval";
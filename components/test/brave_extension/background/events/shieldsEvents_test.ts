@@ -24,4 +24,21 @@ describe('shieldsEvents events', () => {
       chrome.braveShields.onBlocked.emit(blockedResource)
     })
   })
+  describe('chrome.braveShields.onBlockedBatch listener', () => {
+    let spy: jest.SpyInstance
+    beforeEach(() => {
+      spy = jest.spyOn(actions, 'resourceBlocked')
+    })
+    afterEach(() => {
+      spy.mockRestore()
+    })
+    it('forwards each of the details to actions.resourceBlocked', (cb) => {
+      chrome.braveShields.onBlockedBatch.addListener((details) => {
+        expect(spy).toHaveBeenCalledTimes(2)
+        expect(spy).toBeCalledWith(blockedResource)
+        cb()
+      })
+      chrome.braveShields.onBlockedBatch.emit([blockedResource, blockedResource])
+    })
+  })
 })
@@ -212,6 +212,7 @@ export const getMockChrome = () => {
     },
     braveShields: {
       onBlocked: new ChromeEvent(),
+      onBlockedBatch: new ChromeEvent(),
       allowScriptsOnce: function (origins: Array<string>, tabId: number, cb: () => void) {
         setImmediate(cb)
       },
@@ -294,6 +295,7 @@ export const getMockChrome = () => {
         return Promise.resolve()
       },
       onBlocked: new ChromeEvent(),
+      onBlockedBatch: new ChromeEvent(),
       allowScriptsOnce: function (origins: Array<string>, tabId: number, cb: () => void) {
         setImmediate(cb)
       },
@@ -10,13 +10,13 @@
 #include <vector>
 
 #include "base/bind_helpers.h"
+#include "base/no_destructor.h"
 #include "base/stl_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/render_messages.h"
 #include "brave/common/shield_exceptions.h"
 #include "brave/content/common/frame_messages.h"
-#include "components/content_settings/core/common/content_settings_pattern.h"
-#include "components/content_settings/core/common/content_settings_utils.h"
+#include "brave/renderer/brave_content_settings_rules_matcher.h"
 #include "content/public/renderer/render_frame.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
@@ -29,6 +29,23 @@
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "url/url_constants.h"
 
+namespace {
+
+// Bounds the settings cached per frame and content setting type. Frames
+// loading subresources from more origins than this recompute the settings.
+constexpr size_t kMaxCachedSettings = 64;
+
+}  // namespace
+
+BraveContentSettingsAgentImpl::SettingsCache::SettingsCache() = default;
+
+BraveContentSettingsAgentImpl::SettingsCache::~SettingsCache() = default;
+
+void BraveContentSettingsAgentImpl::SettingsCache::Clear() {
+  primary_url = GURL();
+  settings.clear();
+}
+
 BraveContentSettingsAgentImpl::BraveContentSettingsAgentImpl(
     content::RenderFrame* render_frame,
     bool should_whitelist,
@@ -61,6 +78,9 @@ void BraveContentSettingsAgentImpl::DidCommitProvisionalLoad(
   if (!is_same_document_navigation) {
     temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
+    brave_shields_settings_.Clear();
+    fingerprinting_settings_.Clear();
+    autoplay_blocking_settings_.Clear();
   }
 
   ContentSettingsAgentImpl::DidCommitProvisionalLoad(
@@ -153,53 +173,57 @@ GURL BraveContentSettingsAgentImpl::GetOriginOrURL(
   return top_origin.GetURL();
 }
 
-ContentSetting BraveContentSettingsAgentImpl::GetFPContentSettingFromRules(
-    const ContentSettingsForOneType& rules,
-    const blink::WebFrame* frame,
-    const GURL& secondary_url) {
-
-  if (rules.size() == 0)
-    return CONTENT_SETTING_DEFAULT;
-
-  const GURL& primary_url = GetOriginOrURL(frame);
-
-  for (const auto& rule : rules) {
-    ContentSettingsPattern secondary_pattern = rule.secondary_pattern;
-    if (rule.secondary_pattern ==
-        ContentSettingsPattern::FromString("https://firstParty/*")) {
-      secondary_pattern = ContentSettingsPattern::FromString(
-          "[*.]" + GetOriginOrURL(frame).HostNoBrackets());
-    }
+const BraveContentSettingRulesMatchers&
+BraveContentSettingsAgentImpl::GetBraveRulesMatchers() {
+  static const base::NoDestructor<RendererContentSettingRules> empty_rules;
+  const BraveContentSettingRulesMatchers& matchers =
+      BraveContentSettingRulesMatchers::Get(
+          content_setting_rules_ ? *content_setting_rules_ : *empty_rules);
+
+  if (cached_settings_version_ != matchers.version()) {
+    cached_settings_version_ = matchers.version();
+    brave_shields_settings_.Clear();
+    fingerprinting_settings_.Clear();
+    autoplay_blocking_settings_.Clear();
+  }
+  return matchers;
+}
 
-    if (rule.primary_pattern.Matches(primary_url) &&
-        (secondary_pattern == ContentSettingsPattern::Wildcard() ||
-         secondary_pattern.Matches(secondary_url))) {
-      return rule.GetContentSetting();
-    }
+ContentSetting BraveContentSettingsAgentImpl::GetCachedSetting(
+    const ContentSettingRulesMatcher& matcher,
+    SettingsCache* cache,
+    const GURL& primary_url,
+    const GURL& secondary_url) {
+  // Content settings patterns ignore the path of http(s) urls, so those
+  // resolve to the same setting as their origin. Other schemes are rare
+  // enough to be resolved on each call.
+  if (!secondary_url.SchemeIsHTTPOrHTTPS())
+    return matcher.GetSetting(primary_url, secondary_url);
+
+  if (cache->primary_url != primary_url) {
+    cache->Clear();
+    cache->primary_url = primary_url;
   }
 
-  // for cases which are third party resources and doesn't match any existing
-  // rules, block them by default
-  return CONTENT_SETTING_BLOCK;
+  url::Origin secondary_origin = url::Origin::Create(secondary_url);
+  auto it = cache->settings.find(secondary_origin);
+  if (it != cache->settings.end())
+    return it->second;
+
+  ContentSetting setting = matcher.GetSetting(primary_url, secondary_url);
+  if (cache->settings.size() >= kMaxCachedSettings)
+    cache->settings.clear();
+  cache->settings.emplace(std::move(secondary_origin), setting);
+  return setting;
 }
 
 bool BraveContentSettingsAgentImpl::IsBraveShieldsDown(
     const blink::WebFrame* frame,
     const GURL& secondary_url) {
-  ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  const GURL& primary_url = GetOriginOrURL(frame);
-
-  if (content_setting_rules_) {
-    for (const auto& rule : content_setting_rules_->brave_shields_rules) {
-      if (rule.primary_pattern.Matches(primary_url) &&
-          rule.secondary_pattern.Matches(secondary_url)) {
-        setting = rule.GetContentSetting();
-        break;
-      }
-    }
-  }
-
-  return setting == CONTENT_SETTING_BLOCK;
+  const BraveContentSettingRulesMatchers& matchers = GetBraveRulesMatchers();
+  return GetCachedSetting(matchers.brave_shields(), &brave_shields_settings_,
+                          GetOriginOrURL(frame),
+                          secondary_url) == CONTENT_SETTING_BLOCK;
 }
 
 bool BraveContentSettingsAgentImpl::AllowFingerprinting(
@@ -216,21 +240,13 @@ bool BraveContentSettingsAgentImpl::AllowFingerprinting(
   if (brave::IsWhitelistedFingerprintingException(primary_url, secondary_url)) {
     return true;
   }
-  ContentSettingsForOneType rules;
-  if (content_setting_rules_) {
-      rules = content_setting_rules_->fingerprinting_rules;
-  }
-  ContentSettingPatternSource default_rule = ContentSettingPatternSource(
-      ContentSettingsPattern::Wildcard(),
-      ContentSettingsPattern::FromString("https://firstParty/*"),
-      base::Value::FromUniquePtrValue(
-          content_settings::ContentSettingToValue(CONTENT_SETTING_ALLOW)),
-      std::string(), false);
-  rules.push_back(default_rule);
+  // Third party resources which don't match any rule are blocked by default
+  const BraveContentSettingRulesMatchers& matchers = GetBraveRulesMatchers();
   ContentSetting setting =
-      GetFPContentSettingFromRules(rules, frame, secondary_url);
-  rules.pop_back();
-  bool allow = setting != CONTENT_SETTING_BLOCK;
+      GetCachedSetting(matchers.fingerprinting(), &fingerprinting_settings_,
+                       primary_url, secondary_url);
+  bool allow = setting != CONTENT_SETTING_BLOCK &&
+               setting != CONTENT_SETTING_DEFAULT;
   allow = allow || IsWhitelistedForContentSettings();
 
   if (!allow) {
@@ -255,16 +271,11 @@ bool BraveContentSettingsAgentImpl::AllowAutoplay(bool default_value) {
   const GURL& primary_url = GetOriginOrURL(frame);
   const GURL& secondary_url =
       url::Origin(frame->GetDocument().GetSecurityOrigin()).GetURL();
-  for (const auto& rule : content_setting_rules_->autoplay_rules) {
-    if (rule.primary_pattern == ContentSettingsPattern::Wildcard())
-        continue;
-    if (rule.primary_pattern.Matches(primary_url) &&
-        (rule.secondary_pattern == ContentSettingsPattern::Wildcard() ||
-         rule.secondary_pattern.Matches(secondary_url))) {
-      if (rule.GetContentSetting() == CONTENT_SETTING_BLOCK)
-        return false;
-    }
-  }
+  const BraveContentSettingRulesMatchers& matchers = GetBraveRulesMatchers();
+  if (GetCachedSetting(matchers.autoplay_blocking(),
+                       &autoplay_blocking_settings_, primary_url,
+                       secondary_url) == CONTENT_SETTING_BLOCK)
+    return false;
 
   mojo::Remote<blink::mojom::PermissionService> permission_service;
 
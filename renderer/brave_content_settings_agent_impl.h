@@ -6,6 +6,7 @@
 #ifndef BRAVE_RENDERER_BRAVE_CONTENT_SETTINGS_AGENT_IMPL_H_
 #define BRAVE_RENDERER_BRAVE_CONTENT_SETTINGS_AGENT_IMPL_H_
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -13,11 +14,16 @@
 #include "chrome/renderer/content_settings_agent_impl.h"
 #include "components/content_settings/core/common/content_settings.h"
 #include "components/content_settings/core/common/content_settings_types.h"
+#include "url/gurl.h"
+#include "url/origin.h"
 
 namespace blink {
 class WebLocalFrame;
 }
 
+class BraveContentSettingRulesMatchers;
+class ContentSettingRulesMatcher;
+
 // Handles blocking content per content settings for each RenderFrame.
 class BraveContentSettingsAgentImpl
     : public ContentSettingsAgentImpl {
@@ -46,10 +52,27 @@ class BraveContentSettingsAgentImpl
  private:
   GURL GetOriginOrURL(const blink::WebFrame* frame);
 
-  ContentSetting GetFPContentSettingFromRules(
-      const ContentSettingsForOneType& rules,
-      const blink::WebFrame* frame,
-      const GURL& secondary_url);
+  // Settings resolved for this frame. The primary url doesn't change within
+  // a document, so settings are keyed by the origin of their secondary url
+  // only, and the cache is reset once it holds kMaxCachedSettings entries.
+  struct SettingsCache {
+    SettingsCache();
+    ~SettingsCache();
+
+    void Clear();
+
+    GURL primary_url;
+    std::map<url::Origin, ContentSetting> settings;
+  };
+
+  // Returns the compiled Brave rules, resetting the settings cached for this
+  // frame if the rules have been updated since.
+  const BraveContentSettingRulesMatchers& GetBraveRulesMatchers();
+
+  ContentSetting GetCachedSetting(const ContentSettingRulesMatcher& matcher,
+                                  SettingsCache* cache,
+                                  const GURL& primary_url,
+                                  const GURL& secondary_url);
 
   bool IsBraveShieldsDown(
       const blink::WebFrame* frame,
@@ -73,6 +96,12 @@ class BraveContentSettingsAgentImpl
   // temporary allowed script origins we preloaded for the next load
   base::flat_set<std::string> preloaded_temporarily_allowed_scripts_;
 
+  // Version of the rules the cached settings were resolved from
+  int cached_settings_version_ = -1;
+  SettingsCache brave_shields_settings_;
+  SettingsCache fingerprinting_settings_;
+  SettingsCache autoplay_blocking_settings_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveContentSettingsAgentImpl);
 };
 
@@ -0,0 +1,160 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/renderer/brave_content_settings_rules_matcher.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "base/memory/ptr_util.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
+#include "components/content_settings/core/common/content_settings_utils.h"
+#include "url/gurl.h"
+
+namespace {
+
+const ContentSettingsPattern& FirstPartyPattern() {
+  static const base::NoDestructor<ContentSettingsPattern> pattern(
+      ContentSettingsPattern::FromString("https://firstParty/*"));
+  return *pattern;
+}
+
+ContentSettingsForOneType GetFingerprintingRules(
+    const RendererContentSettingRules& rules) {
+  ContentSettingsForOneType fingerprinting_rules = rules.fingerprinting_rules;
+  fingerprinting_rules.push_back(ContentSettingPatternSource(
+      ContentSettingsPattern::Wildcard(), FirstPartyPattern(),
+      base::Value::FromUniquePtrValue(
+          content_settings::ContentSettingToValue(CONTENT_SETTING_ALLOW)),
+      std::string(), false));
+  return fingerprinting_rules;
+}
+
+ContentSettingsForOneType GetAutoplayBlockingRules(
+    const RendererContentSettingRules& rules) {
+  ContentSettingsForOneType blocking_rules;
+  for (const auto& rule : rules.autoplay_rules) {
+    if (rule.primary_pattern == ContentSettingsPattern::Wildcard() ||
+        rule.GetContentSetting() != CONTENT_SETTING_BLOCK)
+      continue;
+    blocking_rules.push_back(rule);
+  }
+  return blocking_rules;
+}
+
+}  // namespace
+
+ContentSettingRulesMatcher::ContentSettingRulesMatcher(
+    const ContentSettingsForOneType& rules) {
+  rules_.reserve(rules.size());
+  for (const auto& rule : rules) {
+    const size_t index = rules_.size();
+    rules_.push_back({rule.primary_pattern, rule.secondary_pattern,
+                      rule.secondary_pattern ==
+                          ContentSettingsPattern::Wildcard(),
+                      rule.secondary_pattern == FirstPartyPattern(),
+                      rule.GetContentSetting()});
+
+    // IPv6 literals are left unindexed as their brackets may differ from the
+    // host of the url
+    const std::string& host = rule.primary_pattern.GetHost();
+    if (host.empty() || host[0] == '[')
+      unindexed_rules_.push_back(index);
+    else if (rule.primary_pattern.HasDomainWildcard())
+      rules_by_domain_[host].push_back(index);
+    else
+      rules_by_host_[host].push_back(index);
+  }
+}
+
+ContentSettingRulesMatcher::~ContentSettingRulesMatcher() {}
+
+ContentSetting ContentSettingRulesMatcher::GetSetting(
+    const GURL& primary_url,
+    const GURL& secondary_url) const {
+  if (rules_.empty())
+    return CONTENT_SETTING_DEFAULT;
+
+  const GURL& url = primary_url.SchemeIsFileSystem() && primary_url.inner_url()
+                        ? *primary_url.inner_url()
+                        : primary_url;
+  RuleIndices candidates(unindexed_rules_);
+  CollectCandidates(url.host(), &candidates);
+  std::sort(candidates.begin(), candidates.end());
+
+  ContentSettingsPattern first_party_pattern;
+  for (size_t index : candidates) {
+    const Rule& rule = rules_[index];
+    if (!rule.primary_pattern.Matches(primary_url))
+      continue;
+
+    if (rule.secondary_is_first_party) {
+      if (!first_party_pattern.IsValid()) {
+        first_party_pattern = ContentSettingsPattern::FromString(
+            "[*.]" + primary_url.HostNoBrackets());
+      }
+      if (first_party_pattern.Matches(secondary_url))
+        return rule.setting;
+    } else if (rule.secondary_is_wildcard ||
+               rule.secondary_pattern.Matches(secondary_url)) {
+      return rule.setting;
+    }
+  }
+
+  return CONTENT_SETTING_DEFAULT;
+}
+
+void ContentSettingRulesMatcher::CollectCandidates(
+    const std::string& host,
+    RuleIndices* candidates) const {
+  base::StringPiece domain(host);
+  // Patterns are matched against the host without its trailing dot
+  if (!domain.empty() && domain.back() == '.')
+    domain.remove_suffix(1);
+  if (domain.empty())
+    return;
+
+  auto it = rules_by_host_.find(domain.as_string());
+  if (it != rules_by_host_.end())
+    candidates->insert(candidates->end(), it->second.begin(), it->second.end());
+
+  // Walk up the domain, e.g. a.b.com, b.com and com
+  while (!domain.empty()) {
+    it = rules_by_domain_.find(domain.as_string());
+    if (it != rules_by_domain_.end()) {
+      candidates->insert(candidates->end(), it->second.begin(),
+                         it->second.end());
+    }
+    const size_t dot = domain.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    domain.remove_prefix(dot + 1);
+  }
+}
+
+// static
+const BraveContentSettingRulesMatchers& BraveContentSettingRulesMatchers::Get(
+    const RendererContentSettingRules& rules) {
+  static base::NoDestructor<std::unique_ptr<BraveContentSettingRulesMatchers>>
+      matchers;
+  static const RendererContentSettingRules* matched_rules = nullptr;
+
+  if (!*matchers || matched_rules != &rules ||
+      (*matchers)->version() != rules.brave_rules_version) {
+    *matchers = base::WrapUnique(new BraveContentSettingRulesMatchers(rules));
+    matched_rules = &rules;
+  }
+  return **matchers;
+}
+
+BraveContentSettingRulesMatchers::BraveContentSettingRulesMatchers(
+    const RendererContentSettingRules& rules)
+    : brave_shields_(rules.brave_shields_rules),
+      fingerprinting_(GetFingerprintingRules(rules)),
+      autoplay_blocking_(GetAutoplayBlockingRules(rules)),
+      version_(rules.brave_rules_version) {}
+
+BraveContentSettingRulesMatchers::~BraveContentSettingRulesMatchers() {}
@@ -0,0 +1,98 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_RENDERER_BRAVE_CONTENT_SETTINGS_RULES_MATCHER_H_
+#define BRAVE_RENDERER_BRAVE_CONTENT_SETTINGS_RULES_MATCHER_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/macros.h"
+#include "components/content_settings/core/common/content_settings.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+
+class GURL;
+
+// Content setting rules indexed by the host of their primary pattern. Rules
+// keep the precedence of the list they are built from, so the first rule
+// matching both urls wins, but only the rules which can match the host of the
+// primary url are checked.
+class ContentSettingRulesMatcher {
+ public:
+  explicit ContentSettingRulesMatcher(const ContentSettingsForOneType& rules);
+  ~ContentSettingRulesMatcher();
+
+  // Returns the setting of the first rule matching both urls, or
+  // CONTENT_SETTING_DEFAULT if there is none. A "https://firstParty/*"
+  // secondary pattern matches the domain of |primary_url|.
+  ContentSetting GetSetting(const GURL& primary_url,
+                            const GURL& secondary_url) const;
+
+  size_t size() const { return rules_.size(); }
+
+ private:
+  struct Rule {
+    ContentSettingsPattern primary_pattern;
+    ContentSettingsPattern secondary_pattern;
+    bool secondary_is_wildcard;
+    bool secondary_is_first_party;
+    ContentSetting setting;
+  };
+
+  using RuleIndices = std::vector<size_t>;
+
+  void CollectCandidates(const std::string& host,
+                         RuleIndices* candidates) const;
+
+  std::vector<Rule> rules_;
+  // Rules whose primary pattern matches exactly one host
+  std::unordered_map<std::string, RuleIndices> rules_by_host_;
+  // Rules whose primary pattern matches a domain and its subdomains
+  std::unordered_map<std::string, RuleIndices> rules_by_domain_;
+  // Rules which have to be checked for every url, e.g. wildcard hosts
+  RuleIndices unindexed_rules_;
+
+  DISALLOW_COPY_AND_ASSIGN(ContentSettingRulesMatcher);
+};
+
+// Brave's renderer content setting rules compiled into matchers once per rules
+// update from the browser, and shared by all the frames of the process.
+class BraveContentSettingRulesMatchers {
+ public:
+  // Returns the matchers for |rules|, compiling them again if the rules have
+  // been updated since the last call. Must be called on the render thread.
+  static const BraveContentSettingRulesMatchers& Get(
+      const RendererContentSettingRules& rules);
+
+  ~BraveContentSettingRulesMatchers();
+
+  const ContentSettingRulesMatcher& brave_shields() const {
+    return brave_shields_;
+  }
+  // Includes the default rule allowing first party fingerprinting
+  const ContentSettingRulesMatcher& fingerprinting() const {
+    return fingerprinting_;
+  }
+  // Only the blocking rules of specific sites
+  const ContentSettingRulesMatcher& autoplay_blocking() const {
+    return autoplay_blocking_;
+  }
+
+  int version() const { return version_; }
+
+ private:
+  explicit BraveContentSettingRulesMatchers(
+      const RendererContentSettingRules& rules);
+
+  const ContentSettingRulesMatcher brave_shields_;
+  const ContentSettingRulesMatcher fingerprinting_;
+  const ContentSettingRulesMatcher autoplay_blocking_;
+  const int version_;
+
+  DISALLOW_COPY_AND_ASSIGN(BraveContentSettingRulesMatchers);
+};
+
+#endif  // BRAVE_RENDERER_BRAVE_CONTENT_SETTINGS_RULES_MATCHER_H_
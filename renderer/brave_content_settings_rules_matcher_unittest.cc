@@ -0,0 +1,87 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/renderer/brave_content_settings_rules_matcher.h"
+
+#include <string>
+
+#include "components/content_settings/core/common/content_settings_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+typedef testing::Test ContentSettingRulesMatcherTest;
+
+ContentSettingPatternSource Rule(const std::string& primary_pattern,
+                                 const std::string& secondary_pattern,
+                                 ContentSetting setting) {
+  return ContentSettingPatternSource(
+      ContentSettingsPattern::FromString(primary_pattern),
+      ContentSettingsPattern::FromString(secondary_pattern),
+      base::Value::FromUniquePtrValue(
+          content_settings::ContentSettingToValue(setting)),
+      std::string(), false);
+}
+
+TEST_F(ContentSettingRulesMatcherTest, MatchesByHost) {
+  ContentSettingsForOneType rules;
+  rules.push_back(Rule("[*.]brave.com", "*", CONTENT_SETTING_BLOCK));
+  rules.push_back(Rule("https://example.com:443", "*", CONTENT_SETTING_ALLOW));
+  ContentSettingRulesMatcher matcher(rules);
+
+  const GURL secondary_url("https://tracker.com/");
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            matcher.GetSetting(GURL("https://brave.com/"), secondary_url));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            matcher.GetSetting(GURL("http://a.b.brave.com/"), secondary_url));
+  EXPECT_EQ(CONTENT_SETTING_DEFAULT,
+            matcher.GetSetting(GURL("https://notbrave.com/"), secondary_url));
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            matcher.GetSetting(GURL("https://example.com/"), secondary_url));
+  EXPECT_EQ(CONTENT_SETTING_DEFAULT,
+            matcher.GetSetting(GURL("http://example.com/"), secondary_url));
+  EXPECT_EQ(CONTENT_SETTING_DEFAULT,
+            matcher.GetSetting(GURL("https://www.example.com/"),
+                               secondary_url));
+}
+
+TEST_F(ContentSettingRulesMatcherTest, KeepsRulesPrecedence) {
+  ContentSettingsForOneType rules;
+  rules.push_back(
+      Rule("[*.]brave.com", "https://tracker.com/*", CONTENT_SETTING_ALLOW));
+  rules.push_back(Rule("https://www.brave.com:443", "*",
+                       CONTENT_SETTING_BLOCK));
+  rules.push_back(Rule("*", "*", CONTENT_SETTING_ASK));
+  ContentSettingRulesMatcher matcher(rules);
+
+  const GURL primary_url("https://www.brave.com/");
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            matcher.GetSetting(primary_url, GURL("https://tracker.com/a.js")));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            matcher.GetSetting(primary_url, GURL("https://other.com/a.js")));
+  EXPECT_EQ(CONTENT_SETTING_ASK,
+            matcher.GetSetting(GURL("https://brave.com/"),
+                               GURL("https://other.com/a.js")));
+  EXPECT_EQ(CONTENT_SETTING_ASK,
+            matcher.GetSetting(GURL("https://example.com/"),
+                               GURL("https://tracker.com/a.js")));
+}
+
+TEST_F(ContentSettingRulesMatcherTest, MatchesFirstPartySecondaryPattern) {
+  ContentSettingsForOneType rules;
+  rules.push_back(Rule("*", "https://firstParty/*", CONTENT_SETTING_ALLOW));
+  ContentSettingRulesMatcher matcher(rules);
+
+  const GURL primary_url("https://brave.com/");
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            matcher.GetSetting(primary_url, GURL("https://brave.com/")));
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            matcher.GetSetting(primary_url, GURL("http://cdn.brave.com/")));
+  EXPECT_EQ(CONTENT_SETTING_DEFAULT,
+            matcher.GetSetting(primary_url, GURL("https://tracker.com/")));
+}
+
+}  // namespace